@@ -1,15 +1,16 @@
+#include "../include/collect.h"
 #include "../include/stl-algorithms.h"
 #include "../include/xrange.h"
 #include "../include/zip.h"
 
 #include <iostream>
+#include <utility>
 #include <vector>
 
 int main(int, char**) {
     std::vector<int> a{1, 2, 3};
     std::vector<char> b{'a', 'b', 'c'};
-    auto temp = lab::zip(a, b);
-    std::vector<std::pair<int, char>> v{temp.begin(), temp.end()};
+    auto v = lab::collect<std::vector<std::pair<int, char>>>(lab::zip(a, b));
 
     for (auto [x, y] : v) {
         std::cout << x << " " << y << "\n";
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <bit>
+#include <cinttypes>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace lab {
+    namespace base {
+        template<typename Word>
+        constexpr size_t kWordBits = std::numeric_limits<Word>::digits;
+
+        // The low n bits of a word, 0 < n <= kWordBits.
+        template<typename Word>
+        constexpr Word low_bits(size_t n) {
+            return n == kWordBits<Word> ? ~Word(0) : Word((Word(1) << n) - 1);
+        }
+
+        // Position of the first bit in [first, last) equal to value, last if
+        // there is none. Bits are numbered from the lowest bit of words[0].
+        template<typename Word>
+        size_t find_bit(const Word* words, size_t first, size_t last, bool value) {
+            if (first >= last) {
+                return last;
+            }
+
+            const Word flip = value ? Word(0) : ~Word(0);
+            const size_t end_word = (last - 1) / kWordBits<Word>;
+
+            size_t w = first / kWordBits<Word>;
+            Word bits = Word((words[w] ^ flip) & (~Word(0) << (first % kWordBits<Word>)));
+
+            for (; w != end_word; bits = words[++w] ^ flip) {
+                if (bits != 0) {
+                    return w * kWordBits<Word> + std::countr_zero(bits);
+                }
+            }
+
+            bits &= low_bits<Word>(last - w * kWordBits<Word>);
+
+            return bits != 0 ? w * kWordBits<Word> + std::countr_zero(bits) : last;
+        }
+
+        // Number of set bits in [first, last).
+        template<typename Word>
+        size_t count_bits(const Word* words, size_t first, size_t last) {
+            if (first >= last) {
+                return 0;
+            }
+
+            const size_t end_word = (last - 1) / kWordBits<Word>;
+
+            size_t w = first / kWordBits<Word>;
+            Word bits = Word(words[w] & (~Word(0) << (first % kWordBits<Word>)));
+            size_t res = 0;
+
+            for (; w != end_word; bits = words[++w]) {
+                res += std::popcount(bits);
+            }
+
+            return res + std::popcount(Word(bits & low_bits<Word>(last - w * kWordBits<Word>)));
+        }
+    };
+
+    template<typename Word>
+    class bit_span;
+
+    // A random access iterator over the bits of a bit_span. Dereferencing
+    // gives the bit as a bool.
+    template<typename Word>
+    class BitSpanIterator {
+    public:
+        using word_type         = std::remove_const_t<Word>;
+        using value_type        = bool;
+        using reference         = bool;
+        using pointer           = void;
+        using difference_type   = ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+    public:
+        BitSpanIterator() = default;
+
+        BitSpanIterator(Word* words, size_t bit)
+            : words_(words)
+            , bit_(bit)
+        {}
+    public:
+        bool operator==(const BitSpanIterator& other) const {
+            return words_ == other.words_ && bit_ == other.bit_;
+        }
+
+        std::strong_ordering operator<=>(const BitSpanIterator& other) const {
+            return bit_ <=> other.bit_;
+        }
+
+        bool operator*() const {
+            return (words_[bit_ / base::kWordBits<word_type>] >> (bit_ % base::kWordBits<word_type>)) & 1;
+        }
+
+        bool operator[](difference_type n) const {
+            return *(*this + n);
+        }
+
+        BitSpanIterator& operator++() {
+            ++bit_;
+
+            return *this;
+        }
+
+        BitSpanIterator operator++(int) {
+            BitSpanIterator res = *this;
+            ++bit_;
+
+            return res;
+        }
+
+        BitSpanIterator& operator--() {
+            --bit_;
+
+            return *this;
+        }
+
+        BitSpanIterator operator--(int) {
+            BitSpanIterator res = *this;
+            --bit_;
+
+            return res;
+        }
+
+        BitSpanIterator& operator+=(difference_type n) {
+            bit_ += n;
+
+            return *this;
+        }
+
+        BitSpanIterator& operator-=(difference_type n) {
+            bit_ -= n;
+
+            return *this;
+        }
+
+        friend BitSpanIterator operator+(BitSpanIterator it, difference_type n) {
+            return it += n;
+        }
+
+        friend BitSpanIterator operator+(difference_type n, BitSpanIterator it) {
+            return it += n;
+        }
+
+        friend BitSpanIterator operator-(BitSpanIterator it, difference_type n) {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const BitSpanIterator& a, const BitSpanIterator& b) {
+            return static_cast<difference_type>(a.bit_) - static_cast<difference_type>(b.bit_);
+        }
+
+        // The words and the bit position within them, for the word-level
+        // algorithms.
+        Word* words() const {
+            return words_;
+        }
+
+        size_t bit() const {
+            return bit_;
+        }
+    private:
+        Word* words_ = nullptr;
+        size_t bit_ = 0;
+    };
+
+    // A view of size bits stored in an array of unsigned words, lowest bit
+    // first, starting offset bits into the first word. Bitmaps kept as raw
+    // words (e.g. read from a file, or the blocks of a bitset-like type) can
+    // be queried with the lab algorithms, which then work a word at a time:
+    //
+    //     lab::bit_span flags(words.data(), 1000);
+    //     lab::find_not(flags.begin(), flags.end(), true);
+    template<typename Word = const uint64_t>
+    class bit_span {
+        static_assert(std::is_unsigned_v<std::remove_const_t<Word>>, "bit_span needs an unsigned word type");
+    public:
+        using word_type       = std::remove_const_t<Word>;
+        using value_type      = bool;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+        using iterator        = BitSpanIterator<Word>;
+        using const_iterator  = iterator;
+    public:
+        bit_span() = default;
+
+        bit_span(Word* words, size_type size, size_type offset = 0)
+            : words_(words)
+            , offset_(offset)
+            , size_(size)
+        {}
+    public:
+        iterator begin() const {
+            return iterator(words_, offset_);
+        }
+
+        iterator end() const {
+            return iterator(words_, offset_ + size_);
+        }
+
+        bool operator[](size_type i) const {
+            return begin()[static_cast<difference_type>(i)];
+        }
+
+        void set(size_type i, bool value) const requires (!std::is_const_v<Word>) {
+            size_type bit = offset_ + i;
+            word_type mask = word_type(word_type(1) << (bit % base::kWordBits<word_type>));
+            word_type& word = words_[bit / base::kWordBits<word_type>];
+
+            word = value ? word_type(word | mask) : word_type(word & ~mask);
+        }
+
+        size_type size() const {
+            return size_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        Word* words() const {
+            return words_;
+        }
+
+        size_type offset() const {
+            return offset_;
+        }
+    private:
+        Word* words_ = nullptr;
+        size_type offset_ = 0;
+        size_type size_ = 0;
+    };
+
+    template<typename Word>
+    bit_span(Word*, size_t) -> bit_span<Word>;
+
+    template<typename Word>
+    bit_span(Word*, size_t, size_t) -> bit_span<Word>;
+
+    namespace base {
+        // Iterators whose bits can be read a word at a time: bit_span, and
+        // std::vector<bool> on libstdc++, where the iterator is a word
+        // pointer and a bit offset into it.
+        template<class Iter>
+        struct BitWordsSelector {
+            static constexpr bool value = false;
+        };
+
+        template<typename Word>
+        struct BitWordsSelector<BitSpanIterator<Word>> {
+            static constexpr bool value = true;
+
+            using word_type = std::remove_const_t<Word>;
+
+            static const word_type* words(const BitSpanIterator<Word>& it) {
+                return it.words();
+            }
+
+            static size_t bit(const BitSpanIterator<Word>& it) {
+                return it.bit();
+            }
+        };
+
+#if defined(__GLIBCXX__)
+        template<class Iter>
+            requires std::is_base_of_v<std::_Bit_iterator_base, Iter>
+        struct BitWordsSelector<Iter> {
+            static constexpr bool value = true;
+
+            using word_type = std::_Bit_type;
+
+            static const word_type* words(const Iter& it) {
+                return it._M_p;
+            }
+
+            static size_t bit(const Iter& it) {
+                return it._M_offset;
+            }
+        };
+#endif
+
+        template<class Iter>
+        constexpr bool kBitWords = BitWordsSelector<Iter>::value;
+
+        // [first, last) as bit positions relative to the words of first.
+        template<class Iter>
+        struct BitRange {
+            using Selector = BitWordsSelector<Iter>;
+            using word_type = typename Selector::word_type;
+
+            BitRange(const Iter& from, const Iter& to)
+                : words(Selector::words(from))
+                , first(Selector::bit(from))
+                , last(static_cast<size_t>(Selector::words(to) - words) * kWordBits<word_type> + Selector::bit(to))
+            {}
+
+            size_t find(bool value) const {
+                return find_bit(words, first, last, value);
+            }
+
+            size_t count() const {
+                return count_bits(words, first, last);
+            }
+
+            const word_type* words;
+            size_t first;
+            size_t last;
+        };
+    };
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "xrange.h"
+#include "zip.h"
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lab {
+    namespace base {
+        template<class Range>
+        using RangeValue = std::iter_value_t<decltype(std::begin(std::declval<const Range&>()))>;
+
+        // Makes room for n more elements when both the container can reserve
+        // and the count is known up front.
+        template<class Container>
+        void reserve_more(Container& out, size_t n) {
+            if constexpr (requires { out.reserve(out.size() + n); }) {
+                out.reserve(out.size() + n);
+            }
+        }
+
+        template<
+            class Container,
+            class Value
+        > void append(Container& out, Value&& value) {
+            if constexpr (requires { out.emplace_back(std::forward<Value>(value)); }) {
+                out.emplace_back(std::forward<Value>(value));
+            } else {
+                out.insert(out.end(), std::forward<Value>(value));
+            }
+        }
+
+        template<
+            class Range,
+            class Container
+        > void collect_base(const Range& range, Container& out) {
+            if constexpr (requires { collect_into(range, out); }) {
+                collect_into(range, out);
+            } else {
+                if constexpr (requires { range.size(); }) {
+                    reserve_more(out, range.size());
+                }
+
+                for (auto&& value : range) {
+                    append(out, std::forward<decltype(value)>(value));
+                }
+            }
+        }
+
+        template<
+            class Range,
+            class... Outs,
+            size_t... I
+        > void unzip_base(const Range& range, std::index_sequence<I...>, Outs&... outs) {
+            if constexpr (requires { range.size(); }) {
+                (reserve_more(outs, range.size()), ...);
+            }
+
+            for (auto&& row : range) {
+                (append(outs, std::get<I>(row)), ...);
+            }
+        }
+    };
+
+    // Materializes a range (xrange, zip, any container) into a new
+    // container, reserving exactly once when the size of the range is known:
+    //
+    //     auto pairs = lab::collect<std::vector<std::pair<int, char>>>(lab::zip(a, b));
+    //     auto values = lab::collect<std::vector>(lab::xrange(10));
+    template<
+        class Container,
+        class Range
+    > Container collect(const Range& range) {
+        Container res;
+        base::collect_base(range, res);
+
+        return res;
+    }
+
+    template<
+        template<class...> class Container,
+        class Range
+    > auto collect(const Range& range) {
+        return collect<Container<base::RangeValue<Range>>>(range);
+    }
+
+    // The same, with the container allocating from resource, e.g. a
+    // std::pmr::monotonic_buffer_resource over per-request scratch memory:
+    //
+    //     auto values = lab::collect<std::pmr::vector>(lab::xrange(10), &arena);
+    template<
+        class Container,
+        class Range
+    > Container collect(const Range& range, std::pmr::memory_resource* resource) {
+        auto res = Container(typename Container::allocator_type(resource));
+        base::collect_base(range, res);
+
+        return res;
+    }
+
+    template<
+        template<class...> class Container,
+        class Range
+    > auto collect(const Range& range, std::pmr::memory_resource* resource) {
+        return collect<Container<base::RangeValue<Range>>>(range, resource);
+    }
+
+    // Appends the i-th element of every row of the zip to the i-th output
+    // container, reserving each once when the zip is sized:
+    //
+    //     lab::unzip(lab::zip(a, b), a_copy, b_copy);
+    template<
+        class... Containers,
+        class... Outs
+    > void unzip(const zip<Containers...>& range, Outs&... outs) {
+        static_assert(sizeof...(Outs) == sizeof...(Containers), "unzip needs one output per zipped sequence");
+
+        base::unzip_base(range, std::index_sequence_for<Containers...>(), outs...);
+    }
+};
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "stl-algorithms.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <type_traits>
+
+#if !defined(__SIZEOF_INT128__) && defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace lab {
+    // A fraction estimated from samples, with a Wilson score interval at
+    // about 95% confidence. When every case could be checked the value is
+    // exact and the bounds equal it.
+    struct proportion_estimate {
+        double value = 0;
+        double lower = 0;
+        double upper = 1;
+        size_t samples = 0;
+    };
+
+    // For a range checked in the sense of lab::is_sorted: the fraction of
+    // adjacent pairs out of order (comp does not hold), and the fraction of
+    // all pairs i < j with comp(a[i], a[j]) false.
+    struct sortedness_estimate {
+        proportion_estimate descents;
+        proportion_estimate inversions;
+    };
+
+    // For a range checked in the sense of lab::is_partitioned: the fraction
+    // of elements satisfying p, and the fraction of pairs i < j where a[j]
+    // satisfies p but a[i] does not.
+    struct partition_estimate {
+        proportion_estimate matching;
+        proportion_estimate inversions;
+    };
+
+    namespace base {
+        // z for a two-sided 95% interval.
+        constexpr double kEstimateZ = 1.959963984540054;
+
+        inline proportion_estimate wilson_estimate(size_t hits, size_t samples) {
+            proportion_estimate res;
+            res.samples = samples;
+
+            if (samples == 0) {
+                return res;
+            }
+
+            double n = static_cast<double>(samples);
+            double p = static_cast<double>(hits) / n;
+            double z2 = kEstimateZ * kEstimateZ;
+            double denominator = 1 + z2 / n;
+            double center = (p + z2 / (2 * n)) / denominator;
+            double half = kEstimateZ * std::sqrt(p * (1 - p) / n + z2 / (4 * n * n)) / denominator;
+
+            res.value = p;
+            res.lower = std::max(0.0, center - half);
+            res.upper = std::min(1.0, center + half);
+
+            return res;
+        }
+
+        inline proportion_estimate exact_estimate(size_t hits, size_t total) {
+            proportion_estimate res;
+            res.samples = total;
+
+            if (total != 0) {
+                res.value = res.lower = res.upper = static_cast<double>(hits) / static_cast<double>(total);
+            }
+
+            return res;
+        }
+
+        // The high half of the 128-bit product a * b, from four 32-bit
+        // partial products.
+        inline uint64_t mul_high64_portable(uint64_t a, uint64_t b) {
+            uint64_t a_lo = a & 0xffffffff;
+            uint64_t a_hi = a >> 32;
+            uint64_t b_lo = b & 0xffffffff;
+            uint64_t b_hi = b >> 32;
+
+            uint64_t lo_hi = a_lo * b_hi;
+            uint64_t hi_lo = a_hi * b_lo;
+            uint64_t middle = ((a_lo * b_lo) >> 32) + (lo_hi & 0xffffffff) + (hi_lo & 0xffffffff);
+
+            return a_hi * b_hi + (lo_hi >> 32) + (hi_lo >> 32) + (middle >> 32);
+        }
+
+        inline uint64_t mul_high64(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+            return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return __umulh(a, b);
+#else
+            return mul_high64_portable(a, b);
+#endif
+        }
+
+        // A uniform index in [0, n) from 64 random bits, by the high half of
+        // a widening product. Unlike std::uniform_int_distribution, whose
+        // algorithm is up to the library, this gives the same indices for a
+        // seed everywhere.
+        inline size_t random_below(std::mt19937_64& gen, size_t n) {
+            return static_cast<size_t>(mul_high64(gen(), n));
+        }
+
+        // Whether n * (n - 1) / 2 <= limit, without computing a product
+        // that may overflow: the even one of n and n - 1 is halved first.
+        inline bool pair_count_at_most(size_t n, size_t limit) {
+            size_t a = n % 2 == 0 ? n / 2 : n;
+            size_t b = n % 2 == 0 ? n - 1 : (n - 1) / 2;
+
+            return a == 0 || b <= limit / a;
+        }
+
+        // hits(i, j) over random pairs i < j of [0, n), or over all of them
+        // when there are no more than samples.
+        template<class Hit>
+        proportion_estimate estimate_pairs(size_t n, size_t samples, std::mt19937_64& gen, const Hit& hit) {
+            if (n < 2) {
+                return exact_estimate(0, 0);
+            }
+
+            if (pair_count_at_most(n, samples)) {
+                size_t hits = 0;
+
+                for (size_t i = 0; i < n; ++i) {
+                    for (size_t j = i + 1; j < n; ++j) {
+                        hits += hit(i, j);
+                    }
+                }
+
+                return exact_estimate(hits, n * (n - 1) / 2);
+            }
+
+            size_t hits = 0;
+
+            for (size_t s = 0; s < samples; ++s) {
+                size_t i = random_below(gen, n);
+                size_t j = random_below(gen, n - 1);
+
+                j += j >= i;
+
+                hits += i < j ? hit(i, j) : hit(j, i);
+            }
+
+            return wilson_estimate(hits, samples);
+        }
+
+        // hit(i) over random i in [0, n), or over all of them when there
+        // are no more than samples.
+        template<class Hit>
+        proportion_estimate estimate_positions(size_t n, size_t samples, std::mt19937_64& gen, const Hit& hit) {
+            size_t hits = 0;
+
+            if (n <= samples) {
+                for (size_t i = 0; i < n; ++i) {
+                    hits += hit(i);
+                }
+
+                return exact_estimate(hits, n);
+            }
+
+            for (size_t s = 0; s < samples; ++s) {
+                hits += hit(random_below(gen, n));
+            }
+
+            return wilson_estimate(hits, samples);
+        }
+    };
+
+    // How sorted a random access range roughly is, from samples random
+    // adjacent pairs and samples random pairs, without reading the rest of
+    // it. The same seed gives the same estimate:
+    //
+    //     auto e = lab::estimate_sortedness(column.begin(), column.end(), 10000, 42);
+    //     if (e.descents.upper < 0.01) ... nearly sorted ...
+    template<
+        class RandomIt,
+        class Compare = std::less<>,
+        typename = RequireFwdIter<RandomIt>
+    > sortedness_estimate estimate_sortedness(RandomIt first, RandomIt last, size_t samples, uint64_t seed, Compare comp = Compare()) {
+        static_assert(
+            std::is_convertible_v<typename std::iterator_traits<RandomIt>::iterator_category, std::random_access_iterator_tag>,
+            "estimate_sortedness needs random access iterators"
+        );
+
+        using Diff = std::iter_difference_t<RandomIt>;
+
+        size_t n = static_cast<size_t>(last - first);
+        std::mt19937_64 gen(seed);
+        sortedness_estimate res;
+
+        auto out_of_order = [first, &comp](size_t i, size_t j) -> size_t {
+            return !comp(first[static_cast<Diff>(i)], first[static_cast<Diff>(j)]);
+        };
+
+        if (n >= 2) {
+            res.descents = base::estimate_positions(n - 1, samples, gen, [&out_of_order](size_t i) {
+                return out_of_order(i, i + 1);
+            });
+        }
+
+        res.inversions = base::estimate_pairs(n, samples, gen, out_of_order);
+
+        return res;
+    }
+
+    template<
+        class RandomIt,
+        class Predicate,
+        typename = RequireFwdIter<RandomIt>
+    > partition_estimate estimate_partitioned(RandomIt first, RandomIt last, Predicate p, size_t samples, uint64_t seed) {
+        static_assert(
+            std::is_convertible_v<typename std::iterator_traits<RandomIt>::iterator_category, std::random_access_iterator_tag>,
+            "estimate_partitioned needs random access iterators"
+        );
+
+        using Diff = std::iter_difference_t<RandomIt>;
+
+        size_t n = static_cast<size_t>(last - first);
+        std::mt19937_64 gen(seed);
+        partition_estimate res;
+
+        auto matches = [first, &p](size_t i) -> size_t {
+            return bool(p(first[static_cast<Diff>(i)]));
+        };
+
+        res.matching = base::estimate_positions(n, samples, gen, matches);
+        res.inversions = base::estimate_pairs(n, samples, gen, [&matches](size_t i, size_t j) -> size_t {
+            return !matches(i) && matches(j);
+        });
+
+        return res;
+    }
+};
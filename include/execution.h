@@ -0,0 +1,497 @@
+#pragma once
+
+#include "parallel.h"
+#include "stl-algorithms.h"
+#include "thread-pool.h"
+#include "xrange.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace lab {
+    namespace execution {
+        // Policies for the algorithm overloads below, after the standard
+        // ones. Parallel policies run on DefaultThreadPool() unless given a
+        // pool with on(pool). The unsequenced policy is accepted and runs
+        // like the parallel one.
+        struct sequenced_policy {};
+
+        struct parallel_policy {
+            ThreadPool* pool = nullptr;
+
+            constexpr parallel_policy on(ThreadPool& target) const {
+                return parallel_policy{&target};
+            }
+        };
+
+        struct parallel_unsequenced_policy {
+            ThreadPool* pool = nullptr;
+
+            constexpr parallel_unsequenced_policy on(ThreadPool& target) const {
+                return parallel_unsequenced_policy{&target};
+            }
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+
+        template<typename T>
+        struct is_execution_policy : std::false_type {};
+
+        template<>
+        struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+        template<>
+        struct is_execution_policy<parallel_policy> : std::true_type {};
+
+        template<>
+        struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {};
+
+        template<typename T>
+        inline constexpr bool is_execution_policy_v = is_execution_policy<T>::value;
+    };
+
+    template<typename Policy>
+    using RequireExecutionPolicy = typename
+        std::enable_if<
+            execution::is_execution_policy_v<std::remove_cvref_t<Policy>>
+        >::type;
+
+    namespace base {
+        // Workers look at the shared state between blocks of this many
+        // elements, so an answer found elsewhere stops them quickly.
+        constexpr size_t kCancelCheckBlock = 4096;
+
+        // Ranges shorter than this are not worth waking the pool for.
+        constexpr size_t kParallelMinSize = size_t(1) << 15;
+
+        // Whether the policy asks for threads and the range can be split;
+        // anything else runs the sequential algorithm.
+        template<
+            class Policy,
+            class Iter
+        > constexpr bool kRunsParallel = !std::is_same_v<std::remove_cvref_t<Policy>, execution::sequenced_policy>
+            && std::is_convertible_v<typename std::iterator_traits<Iter>::iterator_category, std::random_access_iterator_tag>;
+
+        template<class Policy>
+        ThreadPool& policy_pool(const Policy& policy) {
+            return policy.pool != nullptr ? *policy.pool : DefaultThreadPool();
+        }
+
+        inline void atomic_lower(std::atomic<size_t>& value, size_t x) {
+            size_t current = value.load(std::memory_order_relaxed);
+
+            while (x < current && !value.compare_exchange_weak(current, x, std::memory_order_relaxed)) {}
+        }
+
+        // Calls f(begin, end) for consecutive blocks of [0, n), at most
+        // kCancelCheckBlock indices each, spreading chunks of blocks over
+        // the pool. A chunk stops at the first block for which f returns
+        // false.
+        template<class Function>
+        void parallel_blocks(ThreadPool& pool, size_t n, const Function& f) {
+            size_t chunk = parallel_grain(n, pool.Size(), 0);
+            size_t chunks = (n + chunk - 1) / chunk;
+
+            parallel_for(pool, xrange<size_t>(chunks), [n, chunk, &f](size_t c) {
+                size_t end = std::min(n, (c + 1) * chunk);
+
+                for (size_t block = c * chunk; block < end; block += kCancelCheckBlock) {
+                    if (!f(block, std::min(end, block + kCancelCheckBlock))) {
+                        return;
+                    }
+                }
+            }, 1);
+        }
+
+        // The smallest index in [0, n) for which test holds, n if there is
+        // none. Blocks past an index already found are skipped. With any,
+        // every worker stops at the first hit and the result is some index
+        // that passes the test, not necessarily the smallest one.
+        template<class Test>
+        size_t parallel_find_first(ThreadPool& pool, size_t n, const Test& test, bool any = false) {
+            std::atomic<size_t> best{n};
+
+            parallel_blocks(pool, n, [n, any, &best, &test](size_t begin, size_t end) {
+                size_t found = best.load(std::memory_order_relaxed);
+
+                if (found <= begin || (any && found < n)) {
+                    return false;
+                }
+
+                for (size_t i = begin; i < end; ++i) {
+                    if (test(i)) {
+                        atomic_lower(best, i);
+
+                        return false;
+                    }
+                }
+
+                return true;
+            });
+
+            return best.load(std::memory_order_relaxed);
+        }
+    };
+
+    // Parallel quantifiers: the range is split across the pool, and every
+    // worker stops as soon as the answer is known. The predicate is called
+    // concurrently and must be safe to call so. The first exception it
+    // throws is rethrown.
+    template<
+        class Policy,
+        class InputIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireInputIter<InputIt>
+    > bool any_of(Policy&& policy, InputIt first, InputIt last, Predicate p) {
+        if constexpr (base::kRunsParallel<Policy, InputIt>) {
+            size_t n = static_cast<size_t>(last - first);
+
+            if (n >= base::kParallelMinSize) {
+                return base::parallel_find_first(base::policy_pool(policy), n, [first, &p](size_t i) {
+                    return bool(p(first[i]));
+                }, true) != n;
+            }
+        }
+
+        return lab::any_of(first, last, p);
+    }
+
+    template<
+        class Policy,
+        class InputIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireInputIter<InputIt>
+    > bool all_of(Policy&& policy, InputIt first, InputIt last, Predicate p) {
+        return !lab::any_of(policy, first, last, [&p](const auto& x) {
+            return !p(x);
+        });
+    }
+
+    template<
+        class Policy,
+        class InputIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireInputIter<InputIt>
+    > bool none_of(Policy&& policy, InputIt first, InputIt last, Predicate p) {
+        return !lab::any_of(policy, first, last, p);
+    }
+
+    // Stops everywhere once a second match is seen.
+    template<
+        class Policy,
+        class InputIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireInputIter<InputIt>
+    > bool one_of(Policy&& policy, InputIt first, InputIt last, Predicate p) {
+        if constexpr (base::kRunsParallel<Policy, InputIt>) {
+            size_t n = static_cast<size_t>(last - first);
+
+            if (n >= base::kParallelMinSize) {
+                std::atomic<size_t> matches{0};
+
+                base::parallel_blocks(base::policy_pool(policy), n, [first, &p, &matches](size_t begin, size_t end) {
+                    if (matches.load(std::memory_order_relaxed) > 1) {
+                        return false;
+                    }
+
+                    for (size_t i = begin; i < end; ++i) {
+                        if (p(first[i]) && matches.fetch_add(1, std::memory_order_relaxed) > 0) {
+                            return false;
+                        }
+                    }
+
+                    return true;
+                });
+
+                return matches.load(std::memory_order_relaxed) == 1;
+            }
+        }
+
+        return lab::one_of(first, last, p);
+    }
+
+    namespace base {
+        // Parallel property checks work on indices: a violation is a failing
+        // adjacent pair, a late predicate match or a mismatched mirror pair.
+        // The search for the smallest such index covers pairs across chunk
+        // boundaries as well. With any, the check stops at any violation.
+        template<
+            class RandomIt,
+            class Compare
+        > size_t parallel_sorted_violation(ThreadPool& pool, RandomIt first, RandomIt last, Compare& comp, bool any) {
+            size_t n = static_cast<size_t>(last - first);
+
+            if (n < 2) {
+                return n;
+            }
+
+            size_t pair = parallel_find_first(pool, n - 1, [first, &comp](size_t i) {
+                return !comp(first[i], first[i + 1]);
+            }, any);
+
+            return pair == n - 1 ? n : pair + 1;
+        }
+
+        // What one chunk of a partition check saw: its first element that
+        // does not satisfy p, its first one that does, and its first one
+        // that does after a miss of the same chunk.
+        struct PartitionSummary {
+            size_t first_miss;
+            size_t first_match;
+            size_t match_after_miss;
+        };
+
+        // A single pass: chunks summarize themselves, and the violation is
+        // the match after the first miss of the chunk holding the first
+        // miss overall, or the first match of any later chunk. Matches
+        // after a miss already seen anywhere are violations on the spot and
+        // stop the chunks past them.
+        template<
+            class RandomIt,
+            class Predicate
+        > size_t parallel_partition_violation(ThreadPool& pool, RandomIt first, RandomIt last, Predicate& p, bool any) {
+            size_t n = static_cast<size_t>(last - first);
+            size_t chunk = parallel_grain(n, pool.Size(), 0);
+            size_t chunks = (n + chunk - 1) / chunk;
+
+            std::vector<PartitionSummary> summaries(chunks, PartitionSummary{n, n, n});
+            std::atomic<size_t> miss{n};
+            std::atomic<size_t> best{n};
+
+            parallel_for(pool, xrange<size_t>(chunks), [n, chunk, any, first, &p, &summaries, &miss, &best](size_t c) {
+                PartitionSummary& summary = summaries[c];
+                size_t end = std::min(n, (c + 1) * chunk);
+
+                for (size_t block = c * chunk; block < end; block += kCancelCheckBlock) {
+                    size_t found = best.load(std::memory_order_relaxed);
+
+                    if (found <= block || (any && found < n)) {
+                        return;
+                    }
+
+                    size_t known_miss = std::min(summary.first_miss, miss.load(std::memory_order_relaxed));
+
+                    for (size_t i = block; i < std::min(end, block + kCancelCheckBlock); ++i) {
+                        if (!p(first[i])) {
+                            if (summary.first_miss == n) {
+                                summary.first_miss = i;
+                                known_miss = std::min(known_miss, i);
+                                atomic_lower(miss, i);
+                            }
+
+                            continue;
+                        }
+
+                        if (summary.first_match == n) {
+                            summary.first_match = i;
+                        }
+
+                        if (known_miss < i) {
+                            if (summary.first_miss < i) {
+                                summary.match_after_miss = i;
+                            }
+
+                            atomic_lower(best, i);
+
+                            return;
+                        }
+                    }
+                }
+            }, 1);
+
+            size_t res = best.load(std::memory_order_relaxed);
+            size_t c = 0;
+
+            while (c < chunks && summaries[c].first_miss == n) {
+                ++c;
+            }
+
+            if (c < chunks) {
+                res = std::min(res, summaries[c].match_after_miss);
+
+                for (++c; c < chunks; ++c) {
+                    res = std::min(res, summaries[c].first_match);
+                }
+            }
+
+            return res;
+        }
+
+        template<
+            class RandomIt,
+            class Predicate
+        > size_t parallel_palindrome_violation(ThreadPool& pool, RandomIt first, RandomIt last, Predicate& p, bool any) {
+            size_t n = static_cast<size_t>(last - first);
+            size_t half = n / 2;
+
+            size_t pair = parallel_find_first(pool, half, [first, n, &p](size_t i) {
+                return !p(first[i], first[n - 1 - i]);
+            }, any);
+
+            return pair == half ? n : pair;
+        }
+
+        struct LessComparator {
+            template<
+                typename T,
+                typename U
+            > bool operator()(const T& a, const U& b) const {
+                return a < b;
+            }
+        };
+    };
+
+    // Parallel property checks. The *_until forms return the first
+    // violating element like their sequential versions; the boolean ones
+    // stop all workers at any violation.
+    template<
+        class Policy,
+        class ForwardIt,
+        class Compare,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireFwdIter<ForwardIt>
+    > ForwardIt is_sorted_until(Policy&& policy, ForwardIt first, ForwardIt last, Compare comp) {
+        if constexpr (base::kRunsParallel<Policy, ForwardIt>) {
+            if (static_cast<size_t>(last - first) >= base::kParallelMinSize) {
+                return first + static_cast<ptrdiff_t>(base::parallel_sorted_violation(base::policy_pool(policy), first, last, comp, false));
+            }
+        }
+
+        return lab::is_sorted_until(first, last, comp);
+    }
+
+    template<
+        class Policy,
+        class ForwardIt,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireFwdIter<ForwardIt>
+    > ForwardIt is_sorted_until(Policy&& policy, ForwardIt first, ForwardIt last) {
+        return lab::is_sorted_until(policy, first, last, base::LessComparator());
+    }
+
+    template<
+        class Policy,
+        class ForwardIt,
+        class Compare,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireFwdIter<ForwardIt>
+    > bool is_sorted(Policy&& policy, ForwardIt first, ForwardIt last, Compare comp) {
+        if constexpr (base::kRunsParallel<Policy, ForwardIt>) {
+            size_t n = static_cast<size_t>(last - first);
+
+            if (n >= base::kParallelMinSize) {
+                return base::parallel_sorted_violation(base::policy_pool(policy), first, last, comp, true) == n;
+            }
+        }
+
+        return lab::is_sorted(first, last, comp);
+    }
+
+    template<
+        class Policy,
+        class ForwardIt,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireFwdIter<ForwardIt>
+    > bool is_sorted(Policy&& policy, ForwardIt first, ForwardIt last) {
+        return lab::is_sorted(policy, first, last, base::LessComparator());
+    }
+
+    // Every element is looked at once at most: chunks record their first
+    // element failing p and the first ones satisfying it, and the summaries
+    // are combined in order.
+    template<
+        class Policy,
+        class InputIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireInputIter<InputIt>
+    > InputIt is_partitioned_until(Policy&& policy, InputIt first, InputIt last, Predicate p) {
+        if constexpr (base::kRunsParallel<Policy, InputIt>) {
+            if (static_cast<size_t>(last - first) >= base::kParallelMinSize) {
+                return first + static_cast<ptrdiff_t>(base::parallel_partition_violation(base::policy_pool(policy), first, last, p, false));
+            }
+        }
+
+        return lab::is_partitioned_until(first, last, p);
+    }
+
+    template<
+        class Policy,
+        class InputIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireInputIter<InputIt>
+    > bool is_partitioned(Policy&& policy, InputIt first, InputIt last, Predicate p) {
+        if constexpr (base::kRunsParallel<Policy, InputIt>) {
+            size_t n = static_cast<size_t>(last - first);
+
+            if (n >= base::kParallelMinSize) {
+                return base::parallel_partition_violation(base::policy_pool(policy), first, last, p, true) == n;
+            }
+        }
+
+        return lab::is_partitioned(first, last, p);
+    }
+
+    template<
+        class Policy,
+        class BidirIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireBidirIter<BidirIt>
+    > BidirIt is_palindrome_until(Policy&& policy, BidirIt first, BidirIt last, Predicate p) {
+        if constexpr (base::kRunsParallel<Policy, BidirIt>) {
+            if (static_cast<size_t>(last - first) >= base::kParallelMinSize) {
+                return first + static_cast<ptrdiff_t>(base::parallel_palindrome_violation(base::policy_pool(policy), first, last, p, false));
+            }
+        }
+
+        return lab::is_palindrome_until(first, last, p);
+    }
+
+    template<
+        class Policy,
+        class BidirIt,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireBidirIter<BidirIt>
+    > BidirIt is_palindrome_until(Policy&& policy, BidirIt first, BidirIt last) {
+        return lab::is_palindrome_until(policy, first, last, base::BasePalindromePredicate());
+    }
+
+    template<
+        class Policy,
+        class BidirIt,
+        class Predicate,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireBidirIter<BidirIt>
+    > bool is_palindrome(Policy&& policy, BidirIt first, BidirIt last, Predicate p) {
+        if constexpr (base::kRunsParallel<Policy, BidirIt>) {
+            size_t n = static_cast<size_t>(last - first);
+
+            if (n >= base::kParallelMinSize) {
+                return base::parallel_palindrome_violation(base::policy_pool(policy), first, last, p, true) == n;
+            }
+        }
+
+        return lab::is_palindrome(first, last, p);
+    }
+
+    template<
+        class Policy,
+        class BidirIt,
+        typename = RequireExecutionPolicy<Policy>,
+        typename = RequireBidirIter<BidirIt>
+    > bool is_palindrome(Policy&& policy, BidirIt first, BidirIt last) {
+        return lab::is_palindrome(policy, first, last, base::BasePalindromePredicate());
+    }
+};
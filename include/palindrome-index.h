@@ -0,0 +1,146 @@
+#pragma once
+
+#include "stl-algorithms.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace lab {
+    // Answers "is [i, j) a palindrome?" about a fixed sequence in O(1),
+    // after an O(n) pass of Manacher's algorithm that finds the longest
+    // palindrome around every center. The answers are those of
+    // lab::is_palindrome(first + i, first + j, p); p must be an
+    // equivalence, since the algorithm reuses comparisons through the
+    // mirror image of a palindrome:
+    //
+    //     lab::palindrome_index index(text.begin(), text.end());
+    //     index.is_palindrome(3, 10);
+    //
+    // The index keeps two radii per element and no reference to the
+    // sequence.
+    class palindrome_index {
+    public:
+        palindrome_index() = default;
+
+        template<
+            class BidirIt,
+            class Predicate = base::BasePalindromePredicate,
+            typename = RequireBidirIter<BidirIt>
+        > palindrome_index(BidirIt first, BidirIt last, Predicate p = Predicate()) {
+            if constexpr (std::is_convertible_v<typename std::iterator_traits<BidirIt>::iterator_category, std::random_access_iterator_tag>) {
+                Build(first, static_cast<size_t>(last - first), p);
+            } else {
+                // Manacher jumps around the sequence, so other iterators are
+                // gathered into an array first.
+                std::vector<BidirIt> its;
+
+                for (; first != last; ++first) {
+                    its.push_back(first);
+                }
+
+                auto at = [&its](size_t i) -> decltype(auto) {
+                    return *its[i];
+                };
+
+                BuildAt(at, its.size(), p);
+            }
+        }
+    public:
+        // Whether [i, j) is a palindrome, for i <= j <= size().
+        bool is_palindrome(size_t i, size_t j) const {
+            size_t length = j - i;
+
+            if (length < 2) {
+                return true;
+            }
+
+            size_t center = i + length / 2;
+
+            return length % 2 == 1 ? odd_[center] >= (length + 1) / 2 : even_[center] >= length / 2;
+        }
+
+        // The longest palindrome centered on element c, and the longest
+        // centered just before it, as [begin, end) positions.
+        std::pair<size_t, size_t> longest_odd(size_t c) const {
+            return {c + 1 - odd_[c], c + odd_[c]};
+        }
+
+        std::pair<size_t, size_t> longest_even(size_t c) const {
+            return {c - even_[c], c + even_[c]};
+        }
+
+        size_t size() const {
+            return odd_.size();
+        }
+
+        bool empty() const {
+            return odd_.empty();
+        }
+    private:
+        // odd_[c]: the largest k such that [c - k + 1, c + k) is a
+        // palindrome. even_[c]: the largest k such that [c - k, c + k) is.
+        std::vector<size_t> odd_;
+        std::vector<size_t> even_;
+    private:
+        template<
+            class RandomIt,
+            class Predicate
+        > void Build(RandomIt first, size_t n, Predicate& p) {
+            auto at = [first](size_t i) -> decltype(auto) {
+                return first[static_cast<std::iter_difference_t<RandomIt>>(i)];
+            };
+
+            BuildAt(at, n, p);
+        }
+
+        template<
+            class At,
+            class Predicate
+        > void BuildAt(const At& at, size_t n, Predicate& p) {
+            odd_.assign(n, 0);
+            even_.assign(n, 0);
+
+            // [left, right) is the rightmost palindrome found so far; inside
+            // it, a center starts from the radius of its mirror image.
+            size_t left = 0;
+            size_t right = 0;
+
+            for (size_t c = 0; c < n; ++c) {
+                size_t k = c < right ? std::min(odd_[left + right - 1 - c], right - c) : 1;
+
+                while (k <= c && c + k < n && p(at(c - k), at(c + k))) {
+                    ++k;
+                }
+
+                odd_[c] = k;
+
+                if (c + k > right) {
+                    left = c + 1 - k;
+                    right = c + k;
+                }
+            }
+
+            left = 0;
+            right = 0;
+
+            for (size_t c = 0; c < n; ++c) {
+                size_t k = c < right ? std::min(even_[left + right - c], right - c) : 0;
+
+                while (k < c && c + k < n && p(at(c - k - 1), at(c + k))) {
+                    ++k;
+                }
+
+                even_[c] = k;
+
+                if (c + k > right) {
+                    left = c - k;
+                    right = c + k;
+                }
+            }
+        }
+    };
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "thread-pool.h"
+#include "xrange-nd.h"
+#include "xrange.h"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace lab {
+    namespace base {
+        // Chunks are multiples of this many indices, so that neighbouring
+        // chunks rarely write to the same cache line of an index-addressed
+        // array.
+        constexpr size_t kParallelChunkAlign = 64;
+
+        // Chunks per thread when the grain is picked automatically: enough
+        // slack for stealing to even out uneven work.
+        constexpr size_t kParallelChunksPerThread = 8;
+
+        inline size_t parallel_grain(size_t size, size_t threads, size_t grain) {
+            if (grain != 0) {
+                return grain;
+            }
+
+            grain = (size + threads * kParallelChunksPerThread - 1) / (threads * kParallelChunksPerThread);
+
+            // Aligning a smaller grain would merge a short range of heavy
+            // iterations into a chunk or two and leave the other threads idle.
+            if (grain < kParallelChunkAlign) {
+                return std::max<size_t>(1, grain);
+            }
+
+            return (grain + kParallelChunkAlign - 1) / kParallelChunkAlign * kParallelChunkAlign;
+        }
+
+        // Splits [first, last) in halves along chunk boundaries, leaving the
+        // right half for thieves and descending into the left one, until a
+        // single chunk is left to run.
+        template<
+            class RandomIt,
+            class Function
+        > void parallel_for_split(TaskGroup& group, RandomIt first, RandomIt last, const Function& f, ptrdiff_t grain) {
+            while (last - first > grain) {
+                if (group.IsCancelled()) {
+                    return;
+                }
+
+                ptrdiff_t chunks = (last - first + grain - 1) / grain;
+                RandomIt middle = first + chunks / 2 * grain;
+
+                group.Run([&group, middle, last, &f, grain] {
+                    parallel_for_split(group, middle, last, f, grain);
+                });
+
+                last = middle;
+            }
+
+            for (; first != last; ++first) {
+                f(*first);
+            }
+        }
+    };
+
+    // Calls f for every value of the range, spreading contiguous chunks of
+    // grain values over the pool. A grain of zero picks one automatically.
+    // The first exception thrown by f stops scheduling further chunks and is
+    // rethrown once the running ones finish.
+    template<
+        typename T,
+        class Function
+    > void parallel_for(ThreadPool& pool, const xrange<T>& range, Function f, size_t grain = 0) {
+        if (range.empty()) {
+            return;
+        }
+
+        ptrdiff_t chunk = static_cast<ptrdiff_t>(base::parallel_grain(range.size(), pool.Size(), grain));
+        TaskGroup group(pool);
+
+        group.Run([&group, &range, &f, chunk] {
+            base::parallel_for_split(group, range.begin(), range.end(), f, chunk);
+        });
+
+        group.Wait();
+    }
+
+    template<
+        typename T,
+        class Function
+    > void parallel_for(const xrange<T>& range, Function f, size_t grain = 0) {
+        parallel_for(DefaultThreadPool(), range, std::move(f), grain);
+    }
+
+    // Rows of the outermost dimension are the unit of work, grain of them
+    // per chunk. A row already spans many cache lines, so the automatic
+    // grain is not aligned.
+    template<
+        typename T,
+        size_t N,
+        class Function
+    > void parallel_for(ThreadPool& pool, const xrange_nd<T, N>& range, Function f, size_t grain = 0) {
+        size_t rows = range.upper()[0] - range.lower()[0];
+        size_t parts = pool.Size() * base::kParallelChunksPerThread;
+
+        if (grain == 0) {
+            grain = std::max<size_t>(1, (rows + parts - 1) / parts);
+        }
+
+        parallel_for(pool, xrange<size_t>(range.lower()[0], range.upper()[0]), [&range, &f](size_t row) {
+            std::array<size_t, N> lo = range.lower();
+            std::array<size_t, N> hi = range.upper();
+            lo[0] = row;
+            hi[0] = row + 1;
+
+            for (const auto& index : xrange_nd<T, N>(range.ranges(), lo, hi)) {
+                f(index);
+            }
+        }, grain);
+    }
+
+    template<
+        typename T,
+        size_t N,
+        class Function
+    > void parallel_for(const xrange_nd<T, N>& range, Function f, size_t grain = 0) {
+        parallel_for(DefaultThreadPool(), range, std::move(f), grain);
+    }
+
+    // Tiles are the unit of work, grain of them per chunk; each thread walks
+    // whole tiles.
+    template<
+        typename T,
+        size_t N,
+        class Function
+    > void parallel_for(ThreadPool& pool, const tiled_xrange<T, N>& range, Function f, size_t grain = 1) {
+        parallel_for(pool, xrange<size_t>(range.tile_count()), [&range, &f](size_t tile) {
+            for (const auto& index : range.tile(tile)) {
+                f(index);
+            }
+        }, grain);
+    }
+
+    template<
+        typename T,
+        size_t N,
+        class Function
+    > void parallel_for(const tiled_xrange<T, N>& range, Function f, size_t grain = 1) {
+        parallel_for(DefaultThreadPool(), range, std::move(f), grain);
+    }
+};
@@ -0,0 +1,1130 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LAB_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace lab {
+    namespace simd {
+        enum class Isa {
+            Scalar,
+            Sse2,
+            Avx2,
+            Avx512
+        };
+
+        struct CpuFeatures {
+            Isa isa = Isa::Scalar;
+            bool fma = false;
+        };
+
+        // Kernels are compiled for each instruction set with target
+        // attributes and picked at run time, so the library itself needs no
+        // -m flags.
+        inline const CpuFeatures& DetectCpu() {
+            static const CpuFeatures features = [] {
+                CpuFeatures res;
+#if defined(LAB_SIMD_X86)
+                __builtin_cpu_init();
+
+                if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                    res.isa = Isa::Avx512;
+                } else if (__builtin_cpu_supports("avx2")) {
+                    res.isa = Isa::Avx2;
+                } else if (__builtin_cpu_supports("sse2")) {
+                    res.isa = Isa::Sse2;
+                }
+
+                res.fma = __builtin_cpu_supports("fma");
+#endif
+                return res;
+            }();
+
+            return features;
+        }
+
+        inline bool Supports(Isa isa) {
+            return DetectCpu().isa >= isa;
+        }
+
+        namespace detail {
+            // Unsigned arithmetic no narrower than int: wraps instead of
+            // overflowing, and never promotes back to a signed type.
+            template<typename T>
+            using WrapType = std::make_unsigned_t<std::common_type_t<T, int>>;
+
+            template<typename T>
+            T WrapValue(T first, T step, size_t k) {
+                using U = WrapType<T>;
+
+                return static_cast<T>(static_cast<U>(first) + static_cast<U>(k) * static_cast<U>(step));
+            }
+
+            template<
+                typename T,
+                bool Fma
+            > T FloatValue(T start, T step, size_t index) {
+                if constexpr (Fma) {
+                    return std::fma(static_cast<T>(index), step, start);
+                } else {
+                    return start + static_cast<T>(index) * step;
+                }
+            }
+
+            // Outputs at least this large bypass the cache with streaming
+            // stores; they would only evict everything else on the way out.
+            constexpr size_t kStreamBytes = size_t(1) << 23;
+        };
+
+        // out[k] = start + (index + k) * step, k in [0, count). Integral
+        // sequences wrap like xrange values do, floating-point ones compute
+        // every element from its index exactly like the scalar expression.
+        template<
+            typename T,
+            bool Fma = false
+        > void IotaScalar(T* out, size_t count, T start, T step, size_t index) {
+            if constexpr (std::is_integral_v<T>) {
+                T value = detail::WrapValue(start, step, index);
+
+                for (size_t k = 0; k < count; ++k) {
+                    out[k] = value;
+                    value = detail::WrapValue(value, step, 1);
+                }
+            } else {
+                for (size_t k = 0; k < count; ++k) {
+                    out[k] = detail::FloatValue<T, Fma>(start, step, index + k);
+                }
+            }
+        }
+
+#if defined(LAB_SIMD_X86)
+        namespace detail {
+            template<typename T>
+            __attribute__((target("sse2"))) __m128i AddLanesSse2(__m128i a, __m128i b) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm_add_epi8(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm_add_epi16(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm_add_epi32(a, b);
+                } else {
+                    return _mm_add_epi64(a, b);
+                }
+            }
+
+            template<typename T>
+            __attribute__((target("avx2"))) __m256i AddLanesAvx2(__m256i a, __m256i b) {
+                if constexpr (sizeof(T) == 1) {
+                    return _mm256_add_epi8(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm256_add_epi16(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm256_add_epi32(a, b);
+                } else {
+                    return _mm256_add_epi64(a, b);
+                }
+            }
+
+            // Elements to write one by one before out reaches the vector
+            // alignment that streaming stores need.
+            template<typename T>
+            size_t StreamHead(const T* out, size_t count, size_t align) {
+                if (count * sizeof(T) < kStreamBytes) {
+                    return 0;
+                }
+
+                size_t misalign = reinterpret_cast<uintptr_t>(out) % align;
+
+                return misalign == 0 ? 0 : (align - misalign) / sizeof(T);
+            }
+        };
+
+        template<typename T>
+        __attribute__((target("sse2"))) void IotaIntSse2(T* out, size_t count, T start, T step, size_t index) {
+            constexpr size_t lanes = 16 / sizeof(T);
+
+            T first = detail::WrapValue(start, step, index);
+            size_t head = detail::StreamHead(out, count, 16);
+            bool stream = count * sizeof(T) >= detail::kStreamBytes;
+
+            IotaScalar(out, head, first, step, 0);
+
+            alignas(16) T init[lanes];
+            IotaScalar(init, lanes, first, step, head);
+
+            alignas(16) T inc[lanes];
+
+            for (size_t k = 0; k < lanes; ++k) {
+                inc[k] = detail::WrapValue(T(0), step, lanes);
+            }
+
+            __m128i value = _mm_load_si128(reinterpret_cast<const __m128i*>(init));
+            __m128i increment = _mm_load_si128(reinterpret_cast<const __m128i*>(inc));
+
+            size_t i = head;
+
+            for (; i + lanes <= count; i += lanes) {
+                if (stream) {
+                    _mm_stream_si128(reinterpret_cast<__m128i*>(out + i), value);
+                } else {
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), value);
+                }
+
+                value = detail::AddLanesSse2<T>(value, increment);
+            }
+
+            if (stream) {
+                _mm_sfence();
+            }
+
+            IotaScalar(out + i, count - i, first, step, i);
+        }
+
+        template<typename T>
+        __attribute__((target("avx2"))) void IotaIntAvx2(T* out, size_t count, T start, T step, size_t index) {
+            constexpr size_t lanes = 32 / sizeof(T);
+
+            T first = detail::WrapValue(start, step, index);
+            size_t head = detail::StreamHead(out, count, 32);
+            bool stream = count * sizeof(T) >= detail::kStreamBytes;
+
+            IotaScalar(out, head, first, step, 0);
+
+            alignas(32) T init[lanes];
+            alignas(32) T inc[lanes];
+            IotaScalar(init, lanes, first, step, head);
+
+            for (size_t k = 0; k < lanes; ++k) {
+                inc[k] = detail::WrapValue(T(0), step, lanes);
+            }
+
+            __m256i value = _mm256_load_si256(reinterpret_cast<const __m256i*>(init));
+            __m256i increment = _mm256_load_si256(reinterpret_cast<const __m256i*>(inc));
+
+            size_t i = head;
+
+            for (; i + lanes <= count; i += lanes) {
+                if (stream) {
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(out + i), value);
+                } else {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), value);
+                }
+
+                value = detail::AddLanesAvx2<T>(value, increment);
+            }
+
+            if (stream) {
+                _mm_sfence();
+            }
+
+            IotaScalar(out + i, count - i, first, step, i);
+        }
+
+        // Floating-point kernels convert 32-bit lane indices, so the caller
+        // keeps index + count within int32_t.
+        template<typename T>
+        __attribute__((target("sse2"))) void IotaFloatSse2(T* out, size_t count, T start, T step, size_t index) {
+            constexpr size_t lanes = 16 / sizeof(T);
+
+            size_t head = detail::StreamHead(out, count, 16);
+            bool stream = count * sizeof(T) >= detail::kStreamBytes;
+
+            IotaScalar(out, head, start, step, index);
+
+            __m128i lane = std::is_same_v<T, float> ? _mm_setr_epi32(0, 1, 2, 3) : _mm_setr_epi32(0, 1, 0, 0);
+            __m128i position = _mm_add_epi32(_mm_set1_epi32(static_cast<int>(index + head)), lane);
+            __m128i advance = _mm_set1_epi32(static_cast<int>(lanes));
+
+            size_t i = head;
+
+            for (; i + lanes <= count; i += lanes) {
+                if constexpr (std::is_same_v<T, float>) {
+                    __m128 value = _mm_add_ps(_mm_set1_ps(start), _mm_mul_ps(_mm_cvtepi32_ps(position), _mm_set1_ps(step)));
+
+                    if (stream) {
+                        _mm_stream_ps(out + i, value);
+                    } else {
+                        _mm_storeu_ps(out + i, value);
+                    }
+                } else {
+                    __m128d value = _mm_add_pd(_mm_set1_pd(start), _mm_mul_pd(_mm_cvtepi32_pd(position), _mm_set1_pd(step)));
+
+                    if (stream) {
+                        _mm_stream_pd(out + i, value);
+                    } else {
+                        _mm_storeu_pd(out + i, value);
+                    }
+                }
+
+                position = _mm_add_epi32(position, advance);
+            }
+
+            if (stream) {
+                _mm_sfence();
+            }
+
+            IotaScalar(out + i, count - i, start, step, index + i);
+        }
+
+        namespace detail {
+            __attribute__((target("avx2"))) inline void StoreAvx2(float* out, __m256 value, bool stream) {
+                if (stream) {
+                    _mm256_stream_ps(out, value);
+                } else {
+                    _mm256_storeu_ps(out, value);
+                }
+            }
+
+            __attribute__((target("avx2"))) inline void StoreAvx2(double* out, __m256d value, bool stream) {
+                if (stream) {
+                    _mm256_stream_pd(out, value);
+                } else {
+                    _mm256_storeu_pd(out, value);
+                }
+            }
+
+            __attribute__((target("avx2"))) inline __m256 IndexLanesAvx2(float*, __m256i position) {
+                return _mm256_cvtepi32_ps(position);
+            }
+
+            __attribute__((target("avx2"))) inline __m256d IndexLanesAvx2(double*, __m256i position) {
+                return _mm256_cvtepi32_pd(_mm256_castsi256_si128(position));
+            }
+
+            // The plain kernel is compiled without FMA on purpose: with it
+            // enabled, the compiler is free to contract the multiply and add,
+            // and the results would stop matching the scalar expression.
+            __attribute__((target("avx2"))) inline __m256 MulAddAvx2(__m256 x, float step, float start) {
+                return _mm256_add_ps(_mm256_set1_ps(start), _mm256_mul_ps(x, _mm256_set1_ps(step)));
+            }
+
+            __attribute__((target("avx2"))) inline __m256d MulAddAvx2(__m256d x, double step, double start) {
+                return _mm256_add_pd(_mm256_set1_pd(start), _mm256_mul_pd(x, _mm256_set1_pd(step)));
+            }
+
+            __attribute__((target("avx2,fma"))) inline __m256 FmaAvx2(__m256 x, float step, float start) {
+                return _mm256_fmadd_ps(x, _mm256_set1_ps(step), _mm256_set1_ps(start));
+            }
+
+            __attribute__((target("avx2,fma"))) inline __m256d FmaAvx2(__m256d x, double step, double start) {
+                return _mm256_fmadd_pd(x, _mm256_set1_pd(step), _mm256_set1_pd(start));
+            }
+        };
+
+        template<typename T>
+        __attribute__((target("avx2"))) void IotaFloatAvx2(T* out, size_t count, T start, T step, size_t index) {
+            constexpr size_t lanes = 32 / sizeof(T);
+
+            size_t head = detail::StreamHead(out, count, 32);
+            bool stream = count * sizeof(T) >= detail::kStreamBytes;
+
+            IotaScalar(out, head, start, step, index);
+
+            __m256i position = _mm256_add_epi32(
+                _mm256_set1_epi32(static_cast<int>(index + head)),
+                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+            );
+            __m256i advance = _mm256_set1_epi32(static_cast<int>(lanes));
+
+            size_t i = head;
+
+            for (; i + lanes <= count; i += lanes) {
+                detail::StoreAvx2(out + i, detail::MulAddAvx2(detail::IndexLanesAvx2(out, position), step, start), stream);
+                position = _mm256_add_epi32(position, advance);
+            }
+
+            if (stream) {
+                _mm_sfence();
+            }
+
+            IotaScalar(out + i, count - i, start, step, index + i);
+        }
+
+        template<typename T>
+        __attribute__((target("avx2,fma"))) void IotaFloatAvx2Fma(T* out, size_t count, T start, T step, size_t index) {
+            constexpr size_t lanes = 32 / sizeof(T);
+
+            size_t head = detail::StreamHead(out, count, 32);
+            bool stream = count * sizeof(T) >= detail::kStreamBytes;
+
+            IotaScalar<T, true>(out, head, start, step, index);
+
+            __m256i position = _mm256_add_epi32(
+                _mm256_set1_epi32(static_cast<int>(index + head)),
+                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)
+            );
+            __m256i advance = _mm256_set1_epi32(static_cast<int>(lanes));
+
+            size_t i = head;
+
+            for (; i + lanes <= count; i += lanes) {
+                detail::StoreAvx2(out + i, detail::FmaAvx2(detail::IndexLanesAvx2(out, position), step, start), stream);
+                position = _mm256_add_epi32(position, advance);
+            }
+
+            if (stream) {
+                _mm_sfence();
+            }
+
+            IotaScalar<T, true>(out + i, count - i, start, step, index + i);
+        }
+#endif
+
+        template<
+            typename T,
+            bool Fma = false
+        > void Iota(T* out, size_t count, T start, T step, size_t index) {
+#if defined(LAB_SIMD_X86)
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                if (Supports(Isa::Avx2)) {
+                    return IotaIntAvx2(out, count, start, step, index);
+                }
+
+                if (Supports(Isa::Sse2)) {
+                    return IotaIntSse2(out, count, start, step, index);
+                }
+            } else if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+                if (index + count <= static_cast<size_t>(INT32_MAX)) {
+                    if constexpr (Fma) {
+                        if (Supports(Isa::Avx2) && DetectCpu().fma) {
+                            return IotaFloatAvx2Fma(out, count, start, step, index);
+                        }
+                    } else {
+                        if (Supports(Isa::Avx2)) {
+                            return IotaFloatAvx2(out, count, start, step, index);
+                        }
+
+                        if (Supports(Isa::Sse2)) {
+                            return IotaFloatSse2(out, count, start, step, index);
+                        }
+                    }
+                }
+            }
+#endif
+            IotaScalar<T, Fma>(out, count, start, step, index);
+        }
+
+        // Types the find kernels handle: their == is a plain bitwise or IEEE
+        // comparison of whole lanes.
+        template<typename T>
+        constexpr bool kFindable = (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+            || std::is_same_v<T, float>
+            || std::is_same_v<T, double>;
+
+        // Index of the first element that is equal to x (or, when equal is
+        // false, not equal to it), count if there is none.
+        template<typename T>
+        size_t FindScalar(const T* data, size_t count, T x, bool equal) {
+            for (size_t i = 0; i < count; ++i) {
+                if ((data[i] == x) == equal) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+
+        // The same for the last such element.
+        template<typename T>
+        size_t FindLastScalar(const T* data, size_t count, T x, bool equal) {
+            for (size_t i = count; i-- > 0;) {
+                if ((data[i] == x) == equal) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+
+#if defined(LAB_SIMD_X86)
+        namespace detail {
+            // Bits per lane in the masks below: integer compares are turned
+            // into masks byte by byte, floating-point ones lane by lane.
+            template<typename T>
+            constexpr size_t kMaskBits = std::is_floating_point_v<T> ? 1 : sizeof(T);
+
+            template<typename T>
+            __attribute__((target("sse2"))) inline uint32_t EqualMaskSse2(const T* p, T x) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(p), _mm_set1_ps(x)));
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(p), _mm_set1_pd(x)));
+                } else {
+                    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+                    __m128i eq;
+
+                    if constexpr (sizeof(T) == 1) {
+                        eq = _mm_cmpeq_epi8(v, _mm_set1_epi8(static_cast<char>(x)));
+                    } else if constexpr (sizeof(T) == 2) {
+                        eq = _mm_cmpeq_epi16(v, _mm_set1_epi16(static_cast<short>(x)));
+                    } else if constexpr (sizeof(T) == 4) {
+                        eq = _mm_cmpeq_epi32(v, _mm_set1_epi32(static_cast<int>(x)));
+                    } else {
+                        // No 64-bit compare before SSE4.1: both halves of a
+                        // lane have to match.
+                        eq = _mm_cmpeq_epi32(v, _mm_set1_epi64x(static_cast<long long>(x)));
+                        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+                    }
+
+                    return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+                }
+            }
+
+            template<typename T>
+            __attribute__((target("avx2"))) inline uint32_t EqualMaskAvx2(const T* p, T x) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(p), _mm256_set1_ps(x), _CMP_EQ_OQ));
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(p), _mm256_set1_pd(x), _CMP_EQ_OQ));
+                } else {
+                    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+                    __m256i eq;
+
+                    if constexpr (sizeof(T) == 1) {
+                        eq = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(static_cast<char>(x)));
+                    } else if constexpr (sizeof(T) == 2) {
+                        eq = _mm256_cmpeq_epi16(v, _mm256_set1_epi16(static_cast<short>(x)));
+                    } else if constexpr (sizeof(T) == 4) {
+                        eq = _mm256_cmpeq_epi32(v, _mm256_set1_epi32(static_cast<int>(x)));
+                    } else {
+                        eq = _mm256_cmpeq_epi64(v, _mm256_set1_epi64x(static_cast<long long>(x)));
+                    }
+
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+                }
+            }
+
+            // One bit per lane.
+            template<typename T>
+            __attribute__((target("avx512f,avx512bw"))) inline uint64_t EqualMaskAvx512(const T* p, T x) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm512_cmp_ps_mask(_mm512_loadu_ps(p), _mm512_set1_ps(x), _CMP_EQ_OQ);
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm512_cmp_pd_mask(_mm512_loadu_pd(p), _mm512_set1_pd(x), _CMP_EQ_OQ);
+                } else {
+                    __m512i v = _mm512_loadu_si512(p);
+
+                    if constexpr (sizeof(T) == 1) {
+                        return _mm512_cmpeq_epi8_mask(v, _mm512_set1_epi8(static_cast<char>(x)));
+                    } else if constexpr (sizeof(T) == 2) {
+                        return _mm512_cmpeq_epi16_mask(v, _mm512_set1_epi16(static_cast<short>(x)));
+                    } else if constexpr (sizeof(T) == 4) {
+                        return _mm512_cmpeq_epi32_mask(v, _mm512_set1_epi32(static_cast<int>(x)));
+                    } else {
+                        return _mm512_cmpeq_epi64_mask(v, _mm512_set1_epi64(static_cast<long long>(x)));
+                    }
+                }
+            }
+
+            template<
+                typename Mask,
+                size_t Bits
+            > constexpr Mask FullMask() {
+                return Bits >= sizeof(Mask) * 8 ? ~Mask(0) : (Mask(1) << Bits) - 1;
+            }
+        };
+
+        template<typename T>
+        __attribute__((target("sse2"))) size_t FindSse2(const T* data, size_t count, T x, bool equal) {
+            constexpr size_t lanes = 16 / sizeof(T);
+            constexpr uint32_t flip = detail::FullMask<uint32_t, lanes * detail::kMaskBits<T>>();
+
+            uint32_t invert = equal ? 0 : flip;
+            size_t i = 0;
+
+            for (; i + lanes <= count; i += lanes) {
+                uint32_t mask = detail::EqualMaskSse2(data + i, x) ^ invert;
+
+                if (mask != 0) {
+                    return i + __builtin_ctz(mask) / detail::kMaskBits<T>;
+                }
+            }
+
+            return i + FindScalar(data + i, count - i, x, equal);
+        }
+
+        template<typename T>
+        __attribute__((target("sse2"))) size_t FindLastSse2(const T* data, size_t count, T x, bool equal) {
+            constexpr size_t lanes = 16 / sizeof(T);
+            constexpr uint32_t flip = detail::FullMask<uint32_t, lanes * detail::kMaskBits<T>>();
+
+            uint32_t invert = equal ? 0 : flip;
+            size_t i = count;
+
+            for (; i >= lanes; i -= lanes) {
+                uint32_t mask = detail::EqualMaskSse2(data + i - lanes, x) ^ invert;
+
+                if (mask != 0) {
+                    return i - lanes + (31 - __builtin_clz(mask)) / detail::kMaskBits<T>;
+                }
+            }
+
+            size_t res = FindLastScalar(data, i, x, equal);
+
+            return res == i ? count : res;
+        }
+
+        template<typename T>
+        __attribute__((target("avx2"))) size_t FindAvx2(const T* data, size_t count, T x, bool equal) {
+            constexpr size_t lanes = 32 / sizeof(T);
+            constexpr uint32_t flip = detail::FullMask<uint32_t, lanes * detail::kMaskBits<T>>();
+
+            uint32_t invert = equal ? 0 : flip;
+            size_t i = 0;
+
+            for (; i + lanes <= count; i += lanes) {
+                uint32_t mask = detail::EqualMaskAvx2(data + i, x) ^ invert;
+
+                if (mask != 0) {
+                    return i + __builtin_ctz(mask) / detail::kMaskBits<T>;
+                }
+            }
+
+            return i + FindScalar(data + i, count - i, x, equal);
+        }
+
+        template<typename T>
+        __attribute__((target("avx2"))) size_t FindLastAvx2(const T* data, size_t count, T x, bool equal) {
+            constexpr size_t lanes = 32 / sizeof(T);
+            constexpr uint32_t flip = detail::FullMask<uint32_t, lanes * detail::kMaskBits<T>>();
+
+            uint32_t invert = equal ? 0 : flip;
+            size_t i = count;
+
+            for (; i >= lanes; i -= lanes) {
+                uint32_t mask = detail::EqualMaskAvx2(data + i - lanes, x) ^ invert;
+
+                if (mask != 0) {
+                    return i - lanes + (31 - __builtin_clz(mask)) / detail::kMaskBits<T>;
+                }
+            }
+
+            size_t res = FindLastScalar(data, i, x, equal);
+
+            return res == i ? count : res;
+        }
+
+        template<typename T>
+        __attribute__((target("avx512f,avx512bw"))) size_t FindAvx512(const T* data, size_t count, T x, bool equal) {
+            constexpr size_t lanes = 64 / sizeof(T);
+            constexpr uint64_t flip = detail::FullMask<uint64_t, lanes>();
+
+            uint64_t invert = equal ? 0 : flip;
+            size_t i = 0;
+
+            for (; i + lanes <= count; i += lanes) {
+                uint64_t mask = detail::EqualMaskAvx512(data + i, x) ^ invert;
+
+                if (mask != 0) {
+                    return i + __builtin_ctzll(mask);
+                }
+            }
+
+            return i + FindScalar(data + i, count - i, x, equal);
+        }
+
+        template<typename T>
+        __attribute__((target("avx512f,avx512bw"))) size_t FindLastAvx512(const T* data, size_t count, T x, bool equal) {
+            constexpr size_t lanes = 64 / sizeof(T);
+            constexpr uint64_t flip = detail::FullMask<uint64_t, lanes>();
+
+            uint64_t invert = equal ? 0 : flip;
+            size_t i = count;
+
+            for (; i >= lanes; i -= lanes) {
+                uint64_t mask = detail::EqualMaskAvx512(data + i - lanes, x) ^ invert;
+
+                if (mask != 0) {
+                    return i - lanes + (63 - __builtin_clzll(mask));
+                }
+            }
+
+            size_t res = FindLastScalar(data, i, x, equal);
+
+            return res == i ? count : res;
+        }
+#endif
+
+        // Dispatchers: the C library for byte searches, else the widest
+        // kernel the CPU runs.
+        template<typename T>
+        size_t Find(const T* data, size_t count, T x, bool equal) {
+            static_assert(kFindable<T>, "Find needs an integral or float type");
+
+            if (count == 0) {
+                return 0;
+            }
+
+            if constexpr (sizeof(T) == 1) {
+                if (equal) {
+                    const void* res = std::memchr(data, static_cast<unsigned char>(x), count);
+
+                    return res == nullptr ? count : static_cast<const T*>(res) - data;
+                }
+            }
+#if defined(LAB_SIMD_X86)
+            if (Supports(Isa::Avx512)) {
+                return FindAvx512(data, count, x, equal);
+            }
+
+            if (Supports(Isa::Avx2)) {
+                return FindAvx2(data, count, x, equal);
+            }
+
+            if (Supports(Isa::Sse2)) {
+                return FindSse2(data, count, x, equal);
+            }
+#endif
+            return FindScalar(data, count, x, equal);
+        }
+
+        template<typename T>
+        size_t FindLast(const T* data, size_t count, T x, bool equal) {
+            static_assert(kFindable<T>, "FindLast needs an integral or float type");
+
+            if (count == 0) {
+                return 0;
+            }
+
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+            if constexpr (sizeof(T) == 1) {
+                if (equal) {
+                    const void* res = memrchr(data, static_cast<unsigned char>(x), count);
+
+                    return res == nullptr ? count : static_cast<const T*>(res) - data;
+                }
+            }
+#endif
+#if defined(LAB_SIMD_X86)
+            if (Supports(Isa::Avx512)) {
+                return FindLastAvx512(data, count, x, equal);
+            }
+
+            if (Supports(Isa::Avx2)) {
+                return FindLastAvx2(data, count, x, equal);
+            }
+
+            if (Supports(Isa::Sse2)) {
+                return FindLastSse2(data, count, x, equal);
+            }
+#endif
+            return FindLastScalar(data, count, x, equal);
+        }
+
+        // Index of the first element that is not greater than the one
+        // before it (the strict order of lab::is_sorted), count if there is
+        // none.
+        template<typename T>
+        size_t SortedUntilScalar(const T* data, size_t count) {
+            for (size_t i = 1; i < count; ++i) {
+                if (!(data[i - 1] < data[i])) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+
+        // Index of the first element that differs from its mirror image,
+        // count if the range is a palindrome.
+        template<typename T>
+        size_t PalindromeUntilScalar(const T* data, size_t count) {
+            for (size_t i = 0; i < count / 2; ++i) {
+                if (!(data[i] == data[count - 1 - i])) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+
+#if defined(LAB_SIMD_X86)
+        namespace detail {
+            // Bit per byte (integers) or per lane (floats), set where a < b.
+            template<typename T>
+            __attribute__((target("avx2"))) inline uint32_t LessMaskAvx2(const T* a, const T* b) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(a), _mm256_loadu_ps(b), _CMP_LT_OQ));
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(a), _mm256_loadu_pd(b), _CMP_LT_OQ));
+                } else {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+                    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+                    __m256i gt;
+
+                    // Unsigned order is signed order with the sign bits
+                    // flipped.
+                    if constexpr (sizeof(T) == 1) {
+                        if constexpr (std::is_unsigned_v<T>) {
+                            x = _mm256_xor_si256(x, _mm256_set1_epi8(static_cast<char>(0x80)));
+                            y = _mm256_xor_si256(y, _mm256_set1_epi8(static_cast<char>(0x80)));
+                        }
+
+                        gt = _mm256_cmpgt_epi8(y, x);
+                    } else if constexpr (sizeof(T) == 2) {
+                        if constexpr (std::is_unsigned_v<T>) {
+                            x = _mm256_xor_si256(x, _mm256_set1_epi16(static_cast<short>(0x8000)));
+                            y = _mm256_xor_si256(y, _mm256_set1_epi16(static_cast<short>(0x8000)));
+                        }
+
+                        gt = _mm256_cmpgt_epi16(y, x);
+                    } else if constexpr (sizeof(T) == 4) {
+                        if constexpr (std::is_unsigned_v<T>) {
+                            x = _mm256_xor_si256(x, _mm256_set1_epi32(INT32_MIN));
+                            y = _mm256_xor_si256(y, _mm256_set1_epi32(INT32_MIN));
+                        }
+
+                        gt = _mm256_cmpgt_epi32(y, x);
+                    } else {
+                        if constexpr (std::is_unsigned_v<T>) {
+                            x = _mm256_xor_si256(x, _mm256_set1_epi64x(INT64_MIN));
+                            y = _mm256_xor_si256(y, _mm256_set1_epi64x(INT64_MIN));
+                        }
+
+                        gt = _mm256_cmpgt_epi64(y, x);
+                    }
+
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(gt));
+                }
+            }
+
+            // One bit per lane.
+            template<typename T>
+            __attribute__((target("avx512f,avx512bw"))) inline uint64_t LessMaskAvx512(const T* a, const T* b) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm512_cmp_ps_mask(_mm512_loadu_ps(a), _mm512_loadu_ps(b), _CMP_LT_OQ);
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm512_cmp_pd_mask(_mm512_loadu_pd(a), _mm512_loadu_pd(b), _CMP_LT_OQ);
+                } else {
+                    __m512i x = _mm512_loadu_si512(a);
+                    __m512i y = _mm512_loadu_si512(b);
+
+                    if constexpr (sizeof(T) == 1) {
+                        return std::is_signed_v<T> ? _mm512_cmplt_epi8_mask(x, y) : _mm512_cmplt_epu8_mask(x, y);
+                    } else if constexpr (sizeof(T) == 2) {
+                        return std::is_signed_v<T> ? _mm512_cmplt_epi16_mask(x, y) : _mm512_cmplt_epu16_mask(x, y);
+                    } else if constexpr (sizeof(T) == 4) {
+                        return std::is_signed_v<T> ? _mm512_cmplt_epi32_mask(x, y) : _mm512_cmplt_epu32_mask(x, y);
+                    } else {
+                        return std::is_signed_v<T> ? _mm512_cmplt_epi64_mask(x, y) : _mm512_cmplt_epu64_mask(x, y);
+                    }
+                }
+            }
+
+            // Lane order reversed: within the 128-bit halves with a byte
+            // shuffle, then the halves swapped.
+            template<size_t Size>
+            __attribute__((target("avx2"))) inline __m256i ReverseAvx2(__m256i v) {
+                if constexpr (Size == 1) {
+                    __m256i order = _mm256_setr_epi8(
+                        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0
+                    );
+
+                    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, order), _MM_SHUFFLE(1, 0, 3, 2));
+                } else if constexpr (Size == 2) {
+                    __m256i order = _mm256_setr_epi8(
+                        14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1,
+                        14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1
+                    );
+
+                    return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, order), _MM_SHUFFLE(1, 0, 3, 2));
+                } else if constexpr (Size == 4) {
+                    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+                } else {
+                    return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3));
+                }
+            }
+
+            template<size_t Size>
+            __attribute__((target("avx512f,avx512bw"))) inline __m512i ReverseAvx512(__m512i v) {
+                if constexpr (Size == 1) {
+                    __m512i order = _mm512_broadcast_i32x4(_mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+                    __m512i reversed = _mm512_shuffle_epi8(v, order);
+
+                    return _mm512_shuffle_i64x2(reversed, reversed, _MM_SHUFFLE(0, 1, 2, 3));
+                } else if constexpr (Size == 2) {
+                    __m512i order = _mm512_set_epi16(
+                        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+                        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+                    );
+
+                    return _mm512_permutexvar_epi16(order, v);
+                } else if constexpr (Size == 4) {
+                    return _mm512_permutexvar_epi32(_mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), v);
+                } else {
+                    return _mm512_permutexvar_epi64(_mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), v);
+                }
+            }
+
+            // Set where the lanes are equal as values of T: floats compare
+            // as numbers, not bits.
+            template<typename T>
+            __attribute__((target("avx2"))) inline uint32_t EqualLanesAvx2(__m256i a, __m256i b) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm256_movemask_ps(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm256_movemask_pd(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+                } else if constexpr (sizeof(T) == 1) {
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+                } else if constexpr (sizeof(T) == 2) {
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi16(a, b)));
+                } else if constexpr (sizeof(T) == 4) {
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, b)));
+                } else {
+                    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi64(a, b)));
+                }
+            }
+
+            template<typename T>
+            __attribute__((target("avx512f,avx512bw"))) inline uint64_t EqualLanesAvx512(__m512i a, __m512i b) {
+                if constexpr (std::is_same_v<T, float>) {
+                    return _mm512_cmp_ps_mask(_mm512_castsi512_ps(a), _mm512_castsi512_ps(b), _CMP_EQ_OQ);
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return _mm512_cmp_pd_mask(_mm512_castsi512_pd(a), _mm512_castsi512_pd(b), _CMP_EQ_OQ);
+                } else if constexpr (sizeof(T) == 1) {
+                    return _mm512_cmpeq_epi8_mask(a, b);
+                } else if constexpr (sizeof(T) == 2) {
+                    return _mm512_cmpeq_epi16_mask(a, b);
+                } else if constexpr (sizeof(T) == 4) {
+                    return _mm512_cmpeq_epi32_mask(a, b);
+                } else {
+                    return _mm512_cmpeq_epi64_mask(a, b);
+                }
+            }
+        };
+
+        // Every element is compared with its successor by loading the range
+        // twice, one element apart.
+        template<typename T>
+        __attribute__((target("avx2"))) size_t SortedUntilAvx2(const T* data, size_t count) {
+            constexpr size_t lanes = 32 / sizeof(T);
+            constexpr uint32_t full = detail::FullMask<uint32_t, lanes * detail::kMaskBits<T>>();
+
+            size_t i = 0;
+
+            for (; i + lanes < count; i += lanes) {
+                uint32_t bad = ~detail::LessMaskAvx2(data + i, data + i + 1) & full;
+
+                if (bad != 0) {
+                    return i + __builtin_ctz(bad) / detail::kMaskBits<T> + 1;
+                }
+            }
+
+            return i + SortedUntilScalar(data + i, count - i);
+        }
+
+        template<typename T>
+        __attribute__((target("avx512f,avx512bw"))) size_t SortedUntilAvx512(const T* data, size_t count) {
+            constexpr size_t lanes = 64 / sizeof(T);
+            constexpr uint64_t full = detail::FullMask<uint64_t, lanes>();
+
+            size_t i = 0;
+
+            for (; i + lanes < count; i += lanes) {
+                uint64_t bad = ~detail::LessMaskAvx512(data + i, data + i + 1) & full;
+
+                if (bad != 0) {
+                    return i + __builtin_ctzll(bad) + 1;
+                }
+            }
+
+            return i + SortedUntilScalar(data + i, count - i);
+        }
+
+        // A block from the front is compared with the mirrored block from
+        // the back, reversed in registers.
+        template<typename T>
+        __attribute__((target("avx2"))) size_t PalindromeUntilAvx2(const T* data, size_t count) {
+            constexpr size_t lanes = 32 / sizeof(T);
+            constexpr uint32_t full = detail::FullMask<uint32_t, lanes * detail::kMaskBits<T>>();
+
+            size_t half = count / 2;
+            size_t i = 0;
+
+            for (; i + lanes <= half; i += lanes) {
+                __m256i front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + count - i - lanes));
+                uint32_t bad = ~detail::EqualLanesAvx2<T>(front, detail::ReverseAvx2<sizeof(T)>(back)) & full;
+
+                if (bad != 0) {
+                    return i + __builtin_ctz(bad) / detail::kMaskBits<T>;
+                }
+            }
+
+            for (; i < half; ++i) {
+                if (!(data[i] == data[count - 1 - i])) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+
+        template<typename T>
+        __attribute__((target("avx512f,avx512bw"))) size_t PalindromeUntilAvx512(const T* data, size_t count) {
+            constexpr size_t lanes = 64 / sizeof(T);
+            constexpr uint64_t full = detail::FullMask<uint64_t, lanes>();
+
+            size_t half = count / 2;
+            size_t i = 0;
+
+            for (; i + lanes <= half; i += lanes) {
+                __m512i front = _mm512_loadu_si512(data + i);
+                __m512i back = _mm512_loadu_si512(data + count - i - lanes);
+                uint64_t bad = ~detail::EqualLanesAvx512<T>(front, detail::ReverseAvx512<sizeof(T)>(back)) & full;
+
+                if (bad != 0) {
+                    return i + __builtin_ctzll(bad);
+                }
+            }
+
+            for (; i < half; ++i) {
+                if (!(data[i] == data[count - 1 - i])) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+#endif
+
+        // The shuffles and 64-bit compares these need start with AVX2, so
+        // older CPUs take the scalar loops.
+        template<typename T>
+        size_t SortedUntil(const T* data, size_t count) {
+            static_assert(kFindable<T>, "SortedUntil needs an integral or float type");
+#if defined(LAB_SIMD_X86)
+            if (Supports(Isa::Avx512)) {
+                return SortedUntilAvx512(data, count);
+            }
+
+            if (Supports(Isa::Avx2)) {
+                return SortedUntilAvx2(data, count);
+            }
+#endif
+            return SortedUntilScalar(data, count);
+        }
+
+        template<typename T>
+        size_t PalindromeUntil(const T* data, size_t count) {
+            static_assert(kFindable<T>, "PalindromeUntil needs an integral or float type");
+#if defined(LAB_SIMD_X86)
+            if (Supports(Isa::Avx512)) {
+                return PalindromeUntilAvx512(data, count);
+            }
+
+            if (Supports(Isa::Avx2)) {
+                return PalindromeUntilAvx2(data, count);
+            }
+#endif
+            return PalindromeUntilScalar(data, count);
+        }
+
+        // A set of bytes as a 256-bit map: bit (b >> 4) & 7 of
+        // rows[b >> 7][b & 15] is set when b is in the set. Each row is
+        // a 16-entry table indexed by the low nibble, which a byte shuffle
+        // looks up for a whole vector at once.
+        struct ByteSet {
+            alignas(16) uint8_t rows[2][16] = {};
+
+            void insert(uint8_t b) {
+                rows[b >> 7][b & 15] |= static_cast<uint8_t>(1u << ((b >> 4) & 7));
+            }
+
+            bool contains(uint8_t b) const {
+                return (rows[b >> 7][b & 15] >> ((b >> 4) & 7)) & 1;
+            }
+        };
+
+        // Index of the first byte that is (with member false, is not) in
+        // the set, count if there is none.
+        inline size_t FindAnyOfScalar(const uint8_t* data, size_t count, const ByteSet& set, bool member) {
+            for (size_t i = 0; i < count; ++i) {
+                if (set.contains(data[i]) == member) {
+                    return i;
+                }
+            }
+
+            return count;
+        }
+
+#if defined(LAB_SIMD_X86)
+        // The row of each byte comes from one of the two tables, chosen by
+        // its top bit, and the bit within the row from a third table
+        // indexed by the high nibble.
+        __attribute__((target("avx2"))) inline size_t FindAnyOfAvx2(const uint8_t* data, size_t count, const ByteSet& set, bool member) {
+            const __m256i low_rows = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows[0])));
+            const __m256i high_rows = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows[1])));
+            const __m256i bit_of = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128
+            );
+            const __m256i nibble = _mm256_set1_epi8(0x0f);
+            const uint32_t flip = member ? 0 : ~0u;
+
+            size_t i = 0;
+
+            for (; i + 32 <= count; i += 32) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+                __m256i low = _mm256_and_si256(v, nibble);
+                __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+                __m256i row = _mm256_blendv_epi8(_mm256_shuffle_epi8(low_rows, low), _mm256_shuffle_epi8(high_rows, low), v);
+                __m256i bit = _mm256_shuffle_epi8(bit_of, high);
+                uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit))) ^ flip;
+
+                if (mask != 0) {
+                    return i + __builtin_ctz(mask);
+                }
+            }
+
+            return i + FindAnyOfScalar(data + i, count - i, set, member);
+        }
+
+        __attribute__((target("avx512f,avx512bw"))) inline size_t FindAnyOfAvx512(const uint8_t* data, size_t count, const ByteSet& set, bool member) {
+            const __m512i low_rows = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows[0])));
+            const __m512i high_rows = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(set.rows[1])));
+            const __m512i bit_of = _mm512_broadcast_i32x4(_mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128));
+            const __m512i nibble = _mm512_set1_epi8(0x0f);
+            const uint64_t flip = member ? 0 : ~uint64_t(0);
+
+            size_t i = 0;
+
+            for (; i + 64 <= count; i += 64) {
+                __m512i v = _mm512_loadu_si512(data + i);
+                __m512i low = _mm512_and_si512(v, nibble);
+                __m512i high = _mm512_and_si512(_mm512_srli_epi16(v, 4), nibble);
+                __m512i row = _mm512_mask_blend_epi8(_mm512_movepi8_mask(v), _mm512_shuffle_epi8(low_rows, low), _mm512_shuffle_epi8(high_rows, low));
+                __m512i bit = _mm512_shuffle_epi8(bit_of, high);
+                uint64_t mask = _mm512_test_epi8_mask(row, bit) ^ flip;
+
+                if (mask != 0) {
+                    return i + __builtin_ctzll(mask);
+                }
+            }
+
+            return i + FindAnyOfScalar(data + i, count - i, set, member);
+        }
+#endif
+
+        inline size_t FindAnyOf(const uint8_t* data, size_t count, const ByteSet& set, bool member) {
+#if defined(LAB_SIMD_X86)
+            if (Supports(Isa::Avx512)) {
+                return FindAnyOfAvx512(data, count, set, member);
+            }
+
+            if (Supports(Isa::Avx2)) {
+                return FindAnyOfAvx2(data, count, set, member);
+            }
+#endif
+            return FindAnyOfScalar(data, count, set, member);
+        }
+    };
+};
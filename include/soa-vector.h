@@ -0,0 +1,404 @@
+#pragma once
+
+#include "zip.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace lab {
+    namespace base {
+        // Columns start on this boundary: a cache line, and the widest
+        // vector load.
+        constexpr size_t kSoaAlign = 64;
+
+        // Capacities are multiples of this many elements, so that every
+        // column is a whole number of aligned vectors long and a kernel may
+        // load a full vector past size() without leaving the allocation.
+        constexpr size_t kSoaCapacityStep = kSoaAlign;
+
+        // Bytes of all columns that for_each_block hands out at once by
+        // default: about half of a typical L1 data cache.
+        constexpr size_t kSoaBlockBytes = 16 * 1024;
+    };
+
+    // A structure of arrays: one column per type, all in a single aligned
+    // allocation and grown together. Rows are reached through the same
+    // reference proxies as lab::zip, columns as std::span:
+    //
+    //     lab::soa_vector<float, float, int> points;
+    //     points.push_back(1.0f, 2.0f, 3);
+    //     for (auto [x, y, id] : points) ...
+    //     for (float& x : points.column<0>()) ...
+    template<typename... Ts>
+    class soa_vector {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+        static_assert((std::is_object_v<Ts> && ...), "soa_vector columns must be object types");
+        static_assert(((alignof(Ts) <= base::kSoaAlign) && ...), "soa_vector columns are aligned to kSoaAlign at most");
+    public:
+        using iterator        = ZipIterator<std::span<Ts>...>;
+        using const_iterator  = ZipIterator<std::span<const Ts>...>;
+        using value_type      = typename iterator::value_type;
+        using reference       = typename iterator::reference;
+        using const_reference = typename const_iterator::reference;
+        using size_type       = size_t;
+        using difference_type = ptrdiff_t;
+    public:
+        soa_vector() = default;
+
+        explicit soa_vector(size_type size) {
+            resize(size);
+        }
+
+        soa_vector(const soa_vector& other) {
+            reserve(other.size_);
+
+            size_t copied = 0;
+
+            try {
+                std::apply([&other, &copied](auto*... to) {
+                    std::apply([&other, &copied, to...](const auto*... from) {
+                        ((std::uninitialized_copy(from, from + other.size_, to), ++copied), ...);
+                    }, other.columns_);
+                }, columns_);
+            } catch (...) {
+                DestroyColumns(columns_, copied, 0, other.size_);
+                Deallocate(storage_);
+
+                throw;
+            }
+
+            size_ = other.size_;
+        }
+
+        soa_vector(soa_vector&& other) noexcept
+            : storage_(std::exchange(other.storage_, nullptr))
+            , columns_(std::exchange(other.columns_, {}))
+            , size_(std::exchange(other.size_, 0))
+            , capacity_(std::exchange(other.capacity_, 0))
+        {}
+
+        soa_vector& operator=(soa_vector other) noexcept {
+            swap(other);
+
+            return *this;
+        }
+
+        ~soa_vector() {
+            clear();
+            Deallocate(storage_);
+        }
+    public:
+        iterator begin() {
+            return MakeIterator<iterator>(Columns(), 0, std::index_sequence_for<Ts...>());
+        }
+
+        iterator end() {
+            return MakeIterator<iterator>(Columns(), size_, std::index_sequence_for<Ts...>());
+        }
+
+        const_iterator begin() const {
+            return MakeIterator<const_iterator>(Columns(), 0, std::index_sequence_for<Ts...>());
+        }
+
+        const_iterator end() const {
+            return MakeIterator<const_iterator>(Columns(), size_, std::index_sequence_for<Ts...>());
+        }
+
+        reference operator[](size_type i) {
+            return begin()[static_cast<difference_type>(i)];
+        }
+
+        const_reference operator[](size_type i) const {
+            return begin()[static_cast<difference_type>(i)];
+        }
+
+        size_type size() const {
+            return size_;
+        }
+
+        size_type capacity() const {
+            return capacity_;
+        }
+
+        bool empty() const {
+            return size_ == 0;
+        }
+
+        template<size_t I>
+        auto* data() {
+            return std::get<I>(columns_);
+        }
+
+        template<size_t I>
+        const auto* data() const {
+            return std::get<I>(columns_);
+        }
+
+        template<size_t I>
+        auto column() {
+            return std::span(std::get<I>(columns_), size_);
+        }
+
+        template<size_t I>
+        auto column() const {
+            return std::span<const std::tuple_element_t<I, std::tuple<Ts...>>>(std::get<I>(columns_), size_);
+        }
+
+        void reserve(size_type capacity) {
+            if (capacity > capacity_) {
+                Reallocate(capacity, [](const std::tuple<Ts*...>&) {}, 0);
+            }
+        }
+
+        void resize(size_type size) {
+            if (size < size_) {
+                DestroyRows(size, size_);
+                size_ = size;
+
+                return;
+            }
+
+            reserve(size);
+
+            size_t built = 0;
+
+            try {
+                std::apply([this, size, &built](auto*... columns) {
+                    ((std::uninitialized_value_construct(columns + size_, columns + size), ++built), ...);
+                }, columns_);
+            } catch (...) {
+                DestroyColumns(columns_, built, size_, size);
+
+                throw;
+            }
+
+            size_ = size;
+        }
+
+        void clear() {
+            DestroyRows(0, size_);
+            size_ = 0;
+        }
+
+        // Appends a row: one value per column, each forwarded to the
+        // constructor of its column's element. The values may refer to
+        // rows of the vector itself: on growth the new row is built in the
+        // new allocation before the old rows are moved out.
+        template<typename... Us>
+        void push_back(Us&&... values) {
+            static_assert(sizeof...(Us) == sizeof...(Ts), "push_back needs one value per column");
+
+            auto build = [&](const std::tuple<Ts*...>& columns) {
+                ConstructRow(columns, std::index_sequence_for<Ts...>(), std::forward<Us>(values)...);
+            };
+
+            if (size_ == capacity_) {
+                Reallocate(std::max<size_type>(size_ + 1, 2 * capacity_), build, 1);
+            } else {
+                build(columns_);
+            }
+
+            ++size_;
+        }
+
+        void pop_back() {
+            DestroyRows(size_ - 1, size_);
+            --size_;
+        }
+
+        // Calls f(offset, columns...) for consecutive blocks of rows, with
+        // each column of the block as a std::span, so that a kernel can run
+        // over contiguous column pieces. A block of zero picks a multiple of
+        // the capacity step whose rows fit in about half of the L1 cache;
+        // then every span starts on an aligned boundary.
+        template<class Function>
+        void for_each_block(Function f, size_type block = 0) {
+            ForEachBlock(*this, f, block);
+        }
+
+        template<class Function>
+        void for_each_block(Function f, size_type block = 0) const {
+            ForEachBlock(*this, f, block);
+        }
+
+        void swap(soa_vector& other) noexcept {
+            std::swap(storage_, other.storage_);
+            std::swap(columns_, other.columns_);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+
+        friend void swap(soa_vector& a, soa_vector& b) noexcept {
+            a.swap(b);
+        }
+    private:
+        void* storage_ = nullptr;
+        std::tuple<Ts*...> columns_{};
+        size_type size_ = 0;
+        size_type capacity_ = 0;
+    private:
+        static size_type RoundCapacity(size_type capacity) {
+            return (capacity + base::kSoaCapacityStep - 1) / base::kSoaCapacityStep * base::kSoaCapacityStep;
+        }
+
+        static size_type DefaultBlock() {
+            size_type row_bytes = (sizeof(Ts) + ...);
+
+            return std::max<size_type>(1, base::kSoaBlockBytes / row_bytes / base::kSoaCapacityStep) * base::kSoaCapacityStep;
+        }
+
+        static void Deallocate(void* storage) {
+            if (storage != nullptr) {
+                ::operator delete(storage, std::align_val_t(base::kSoaAlign));
+            }
+        }
+
+        template<
+            class Self,
+            class Function
+        > static void ForEachBlock(Self& self, Function& f, size_type block) {
+            if (block == 0) {
+                block = DefaultBlock();
+            }
+
+            for (size_type offset = 0; offset < self.size_; offset += block) {
+                size_type count = std::min(block, self.size_ - offset);
+
+                std::apply([&f, offset, count](auto*... columns) {
+                    f(offset, std::span(columns + offset, count)...);
+                }, self.Columns());
+            }
+        }
+
+        std::tuple<Ts*...> Columns() {
+            return columns_;
+        }
+
+        std::tuple<const Ts*...> Columns() const {
+            return columns_;
+        }
+
+        template<
+            class Iterator,
+            class Columns,
+            size_t... I
+        > Iterator MakeIterator(const Columns& columns, size_type index, std::index_sequence<I...>) const {
+            return Iterator(static_cast<difference_type>(index), (std::span(std::get<I>(columns), size_).begin() + index)...);
+        }
+
+        // Moves (or copies, when moving may throw) every column into a new
+        // allocation with room for at least capacity rows, each column
+        // starting on an aligned boundary. build(columns) first constructs
+        // the appended rows [size_, size_ + appended) of the new allocation,
+        // while the old rows are still in place. Columns that may throw are
+        // relocated before any column is moved from, so that a failure
+        // leaves the old rows untouched.
+        template<class Build>
+        void Reallocate(size_type capacity, const Build& build, size_type appended) {
+            capacity = RoundCapacity(capacity);
+
+            size_type bytes = ((capacity * sizeof(Ts)) + ...);
+            void* storage = ::operator new(bytes, std::align_val_t(base::kSoaAlign));
+            std::tuple<Ts*...> columns = Layout(storage, capacity, std::index_sequence_for<Ts...>());
+            std::array<bool, sizeof...(Ts)> relocated{};
+
+            try {
+                build(columns);
+            } catch (...) {
+                Deallocate(storage);
+
+                throw;
+            }
+
+            try {
+                RelocateColumns<false>(columns, relocated, std::index_sequence_for<Ts...>());
+                RelocateColumns<true>(columns, relocated, std::index_sequence_for<Ts...>());
+            } catch (...) {
+                DestroyMarkedColumns(columns, relocated, 0, size_, std::index_sequence_for<Ts...>());
+                DestroyColumns(columns, sizeof...(Ts), size_, size_ + appended);
+                Deallocate(storage);
+
+                throw;
+            }
+
+            DestroyRows(0, size_);
+            Deallocate(storage_);
+
+            storage_ = storage;
+            columns_ = columns;
+            capacity_ = capacity;
+        }
+
+        template<size_t... I>
+        static std::tuple<Ts*...> Layout(void* storage, size_type capacity, std::index_sequence<I...>) {
+            std::tuple<Ts*...> res;
+            size_type offset = 0;
+
+            ((std::get<I>(res) = reinterpret_cast<Ts*>(static_cast<char*>(storage) + offset), offset += capacity * sizeof(Ts)), ...);
+
+            return res;
+        }
+
+        template<typename T>
+        static void MoveColumn(T* first, T* last, T* to) {
+            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+                std::uninitialized_move(first, last, to);
+            } else {
+                std::uninitialized_copy(first, last, to);
+            }
+        }
+
+        // Relocates the columns whose move is (or is not) nothrow, marking
+        // each one done.
+        template<
+            bool kNothrow,
+            size_t... I
+        > void RelocateColumns(const std::tuple<Ts*...>& to, std::array<bool, sizeof...(Ts)>& relocated, std::index_sequence<I...>) {
+            ((std::is_nothrow_move_constructible_v<Ts> == kNothrow
+                ? (MoveColumn(std::get<I>(columns_), std::get<I>(columns_) + size_, std::get<I>(to)), relocated[I] = true)
+                : false), ...);
+        }
+
+        template<size_t... I>
+        static void DestroyMarkedColumns(const std::tuple<Ts*...>& columns, const std::array<bool, sizeof...(Ts)>& marked, size_type first, size_type last, std::index_sequence<I...>) {
+            ((marked[I] ? std::destroy(std::get<I>(columns) + first, std::get<I>(columns) + last) : void()), ...);
+        }
+
+        // Destroys rows [first, last) of the first count columns.
+        static void DestroyColumns(const std::tuple<Ts*...>& columns, size_t count, size_type first, size_type last) {
+            size_t column = 0;
+
+            std::apply([&column, count, first, last](auto*... ptrs) {
+                ((column++ < count ? std::destroy(ptrs + first, ptrs + last) : void()), ...);
+            }, columns);
+        }
+
+        void DestroyRows(size_type first, size_type last) {
+            DestroyColumns(columns_, sizeof...(Ts), first, last);
+        }
+
+        // Constructs row size_ of the given columns.
+        template<
+            size_t... I,
+            typename... Us
+        > void ConstructRow(const std::tuple<Ts*...>& columns, std::index_sequence<I...>, Us&&... values) {
+            size_t built = 0;
+
+            try {
+                ((std::construct_at(std::get<I>(columns) + size_, std::forward<Us>(values)), ++built), ...);
+            } catch (...) {
+                DestroyColumns(columns, built, size_, size_ + 1);
+
+                throw;
+            }
+        }
+    };
+};
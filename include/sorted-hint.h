@@ -0,0 +1,226 @@
+#pragma once
+
+#include "stl-algorithms.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace lab {
+    namespace base {
+        // Adjacent pairs checked by LAB_DEBUG_SORTED_HINTS.
+        constexpr size_t kSortedHintSamples = 64;
+
+        template<class Iter>
+        constexpr bool kRandomAccess = std::is_convertible_v<
+            typename std::iterator_traits<Iter>::iterator_category,
+            std::random_access_iterator_tag
+        >;
+
+        // Calls check(it, next) for sampled adjacent pairs: random ones on
+        // random access ranges, the first ones otherwise. The positions
+        // depend on the size only, so a check is reproducible.
+        template<
+            class ForwardIt,
+            class Check
+        > void sample_adjacent_pairs(ForwardIt first, ForwardIt last, Check check) {
+            if constexpr (kRandomAccess<ForwardIt>) {
+                auto n = last - first;
+
+                if (n < 2) {
+                    return;
+                }
+
+                std::minstd_rand gen(static_cast<std::minstd_rand::result_type>(n));
+                std::uniform_int_distribution<decltype(n)> position(0, n - 2);
+
+                for (size_t i = 0; i < kSortedHintSamples; ++i) {
+                    ForwardIt it = first + position(gen);
+
+                    check(it, std::next(it));
+                }
+            } else {
+                if (first == last) {
+                    return;
+                }
+
+                ForwardIt next = std::next(first);
+
+                for (size_t i = 0; i < kSortedHintSamples && next != last; ++i, first = next, ++next) {
+                    check(first, next);
+                }
+            }
+        }
+
+        // The first element after first that is greater than x, found by
+        // doubling the step from first and then bisecting the last step:
+        // O(log d) comparisons when it is d elements away.
+        template<
+            class RandomIt,
+            typename T,
+            class Compare
+        > RandomIt gallop_upper_bound(RandomIt first, RandomIt last, const T& x, Compare& comp) {
+            using Diff = std::iter_difference_t<RandomIt>;
+
+            Diff n = last - first;
+            Diff low = 0;
+            Diff step = 1;
+
+            while (step < n && !comp(x, first[step])) {
+                low = step;
+                step *= 2;
+            }
+
+            return std::upper_bound(first + low, first + std::min(step, n), x, std::ref(comp));
+        }
+    };
+
+    // A range the caller promises is sorted by comp, non-descending as
+    // std::sort leaves it. The overloads below taking it search instead of
+    // scanning when the iterators are random access. Elements count as
+    // equal to a value when neither is less than the other, which is ==
+    // for the usual orders.
+    //
+    // With LAB_DEBUG_SORTED_HINTS defined, the promise (and the one made
+    // to partition_point) is checked on a sample of adjacent pairs, and a
+    // broken one throws std::runtime_error.
+    template<
+        class Iter,
+        class Compare
+    > class sorted_view {
+    public:
+        using iterator = Iter;
+    public:
+        sorted_view(Iter first, Iter last, Compare comp)
+            : first_(first)
+            , last_(last)
+            , comp_(std::move(comp))
+        {
+#if defined(LAB_DEBUG_SORTED_HINTS)
+            base::sample_adjacent_pairs(first_, last_, [this](Iter it, Iter next) {
+                if (comp_(*next, *it)) {
+                    throw std::runtime_error("assume_sorted: the range is not sorted.");
+                }
+            });
+#endif
+        }
+    public:
+        Iter begin() const {
+            return first_;
+        }
+
+        Iter end() const {
+            return last_;
+        }
+
+        Compare& comp() const {
+            return comp_;
+        }
+    private:
+        Iter first_;
+        Iter last_;
+        mutable Compare comp_;
+    };
+
+    template<
+        class ForwardIt,
+        class Compare = std::less<>,
+        typename = RequireFwdIter<ForwardIt>
+    > sorted_view<ForwardIt, Compare> assume_sorted(ForwardIt first, ForwardIt last, Compare comp = Compare()) {
+        return sorted_view<ForwardIt, Compare>(first, last, std::move(comp));
+    }
+
+    //     auto sorted = lab::assume_sorted(timestamps);
+    //     auto last_at = lab::find_backward(sorted, t);
+    //     auto after_zeros = lab::find_not(sorted, 0);
+    template<
+        class Range,
+        class Compare = std::less<>
+    > requires std::ranges::forward_range<Range&>
+    auto assume_sorted(Range& range, Compare comp = Compare()) {
+        return lab::assume_sorted(std::ranges::begin(range), std::ranges::end(range), std::move(comp));
+    }
+
+    // The first element not equal to x: on random access ranges that begin
+    // with x, a gallop over the run of x.
+    template<
+        class Iter,
+        class Compare,
+        typename T
+    > Iter find_not(const sorted_view<Iter, Compare>& range, const T& x) {
+        Compare& comp = range.comp();
+        Iter first = range.begin();
+        Iter last = range.end();
+
+        auto equal = [&comp, &x](const auto& a) -> bool {
+            return !comp(a, x) && !comp(x, a);
+        };
+
+        if constexpr (base::kRandomAccess<Iter>) {
+            if (first == last || !equal(*first)) {
+                return first;
+            }
+
+            return base::gallop_upper_bound(first, last, x, comp);
+        } else {
+            return lab::find_if_not(first, last, equal);
+        }
+    }
+
+    // The last element equal to x, found as the one before the upper bound.
+    template<
+        class Iter,
+        class Compare,
+        typename T
+    > Iter find_backward(const sorted_view<Iter, Compare>& range, const T& x) {
+        Compare& comp = range.comp();
+        Iter first = range.begin();
+        Iter last = range.end();
+
+        if constexpr (base::kRandomAccess<Iter>) {
+            Iter it = std::upper_bound(first, last, x, std::ref(comp));
+
+            if (it == first || comp(*std::prev(it), x)) {
+                return last;
+            }
+
+            return std::prev(it);
+        } else {
+            return lab::find_last(first, last, [&comp, &x](const auto& a) -> bool {
+                return !comp(a, x) && !comp(x, a);
+            });
+        }
+    }
+
+    // The first element for which p is false, where p holds on a prefix of
+    // the range, as for a threshold in the order (x < limit): a binary
+    // search on random access ranges.
+    //
+    // Sortedness alone says nothing about whether an arbitrary p
+    // partitions the range, so is_partitioned keeps its linear scan; this
+    // is the O(log n) question to ask instead.
+    template<
+        class Iter,
+        class Compare,
+        class Predicate
+    > Iter partition_point(const sorted_view<Iter, Compare>& range, Predicate p) {
+#if defined(LAB_DEBUG_SORTED_HINTS)
+        base::sample_adjacent_pairs(range.begin(), range.end(), [&p](Iter it, Iter next) {
+            if (!p(*it) && p(*next)) {
+                throw std::runtime_error("partition_point: the predicate does not hold on a prefix.");
+            }
+        });
+#endif
+        if constexpr (base::kRandomAccess<Iter>) {
+            return std::partition_point(range.begin(), range.end(), std::ref(p));
+        } else {
+            return lab::find_if_not<Iter, Predicate&>(range.begin(), range.end(), p);
+        }
+    }
+};
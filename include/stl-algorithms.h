@@ -1,7 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <initializer_list>
 #include <iterator>
 #include <type_traits>
+#include <utility>
+
+#if __cplusplus >= 202002L
+#include "bit-span.h"
+#include "simd.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#endif
 
 namespace lab {
     template<typename T>
@@ -31,6 +43,18 @@ namespace lab {
             >::value
         >::type;
 
+    template<typename T>
+    using RequireCharacter = typename
+        std::enable_if<
+            std::is_same<T, char>::value
+            || std::is_same<T, wchar_t>::value
+#if defined(__cpp_char8_t)
+            || std::is_same<T, char8_t>::value
+#endif
+            || std::is_same<T, char16_t>::value
+            || std::is_same<T, char32_t>::value
+        >::type;
+
     template<typename Iter>
     using RequireBidirIter = typename
         std::enable_if<
@@ -40,13 +64,16 @@ namespace lab {
             >::value
         >::type;
 
+    // Compares the elements that two iterators point to. With Compare a
+    // reference type it refers to the caller's comparator instead of
+    // holding a copy, so that comparators need not be copyable.
     template<typename Compare>
     struct IteratorComparator {
         Compare comp_;
 
         explicit constexpr
         IteratorComparator(Compare comp)
-            : comp_(std::move(comp))
+            : comp_(std::forward<Compare>(comp))
         {}
 
         template<typename Iter1, typename Iter2>
@@ -63,26 +90,53 @@ namespace lab {
             }
         };
 
+        // Refers to the needle and compares it with elements in place, so
+        // neither is copied, and any type comparable with the elements
+        // (e.g. a std::string_view for std::string elements) can be used.
         template<typename T>
         struct BaseFindPredicate {
-            T x;
-            
+            const T& x;
+
             explicit constexpr
-            BaseFindPredicate(T _x)
-                : x(std::move(_x))
+            BaseFindPredicate(const T& _x)
+                : x(_x)
             {}
 
             template<typename U>
-            bool operator()(U a) {
+            bool operator()(const U& a) const {
                 return a == x;
             }
         };
 
+        // The characters of a string literal given as needles, without its
+        // terminating null; an array that does not end in one is taken
+        // whole.
+        template<typename CharT>
+        struct LiteralNeedles {
+            const CharT* first;
+            const CharT* last;
+
+            template<size_t N>
+            explicit constexpr
+            LiteralNeedles(const CharT (&chars)[N])
+                : first(chars)
+                , last(chars + N - (chars[N - 1] == CharT() ? 1 : 0))
+            {}
+
+            constexpr const CharT* begin() const {
+                return first;
+            }
+
+            constexpr const CharT* end() const {
+                return last;
+            }
+        };
+
         struct BasePalindromePredicate {
             template<
                 typename T,
                 typename U
-            > bool operator()(T x, U y) {
+            > bool operator()(const T& x, const U& y) const {
                 return x == y;
             }
         };
@@ -107,6 +161,54 @@ namespace lab {
 
             return true;
         }
+
+        template<
+            class ForwardIt,
+            class Compare,
+            typename = RequireFwdIter<ForwardIt>
+        > ForwardIt is_sorted_until_base(ForwardIt first, ForwardIt last, Compare comp) {
+            if (first == last) {
+                return last;
+            }
+
+            ForwardIt next = first;
+
+            for (++next; next != last; first = next, ++next) {
+                if (!comp(first, next)) {
+                    return next;
+                }
+            }
+
+            return last;
+        }
+
+        template<
+            class InputIt,
+            class Predicate
+        > InputIt find_last_base(InputIt first, InputIt last, Predicate& p, std::input_iterator_tag) {
+            InputIt res = last;
+
+            for (; first != last; ++first) {
+                if (p(*first)) {
+                    res = first;
+                }
+            }
+
+            return res;
+        }
+
+        template<
+            class BidirIt,
+            class Predicate
+        > BidirIt find_last_base(BidirIt first, BidirIt last, Predicate& p, std::bidirectional_iterator_tag) {
+            for (BidirIt it = last; it != first;) {
+                if (p(*--it)) {
+                    return it;
+                }
+            }
+
+            return last;
+        }
 #else
         template<
             class ForwardIt,
@@ -127,11 +229,345 @@ namespace lab {
 
             return true;
         }
+
+        template<
+            class ForwardIt,
+            class Compare,
+            typename = RequireFwdIter<ForwardIt>
+        > constexpr ForwardIt is_sorted_until_base(ForwardIt first, ForwardIt last, Compare comp) {
+            if (first == last) {
+                return last;
+            }
+
+            ForwardIt next = first;
+
+            for (++next; next != last; first = next, ++next) {
+                if (!comp(first, next)) {
+                    return next;
+                }
+            }
+
+            return last;
+        }
+
+        // Without a way back, every element has to be seen; otherwise the
+        // scan starts at the end and stops at the first match.
+        template<
+            class InputIt,
+            class Predicate
+        > constexpr InputIt find_last_base(InputIt first, InputIt last, Predicate& p, std::input_iterator_tag) {
+            InputIt res = last;
+
+            for (; first != last; ++first) {
+                if (p(*first)) {
+                    res = first;
+                }
+            }
+
+            return res;
+        }
+
+        template<
+            class BidirIt,
+            class Predicate
+        > constexpr BidirIt find_last_base(BidirIt first, BidirIt last, Predicate& p, std::bidirectional_iterator_tag) {
+            for (BidirIt it = last; it != first;) {
+                if (p(*--it)) {
+                    return it;
+                }
+            }
+
+            return last;
+        }
 #endif
     };
 
 #if __cplusplus >= 202002L
 
+    namespace base {
+        // Contiguous ranges of integers or floats searched for a value of a
+        // compatible type go to the SIMD kernels. Integers may differ in
+        // type; floating-point types must match, so that comparing in the
+        // element type is the same as comparing in the common type.
+        template<
+            class Iter,
+            typename T
+        > constexpr bool kSimdFindable = []() {
+            if constexpr (std::contiguous_iterator<Iter>) {
+                using V = std::iter_value_t<Iter>;
+
+                return simd::kFindable<V> && (std::is_integral_v<V>
+                    ? std::is_integral_v<T> && !std::is_same_v<T, bool>
+                    : std::is_same_v<V, T>);
+            } else {
+                return false;
+            }
+        }();
+
+        // The first (or with Backward, the last) element that is equal to x,
+        // or with Equal false, not equal to it.
+        template<
+            bool Equal,
+            bool Backward,
+            class Iter,
+            typename T
+        > Iter simd_find(Iter first, Iter last, const T& x) {
+            using V = std::iter_value_t<Iter>;
+
+            const V* data = std::to_address(first);
+            size_t count = static_cast<size_t>(last - first);
+            V needle = static_cast<V>(x);
+
+            if constexpr (std::is_integral_v<V>) {
+                // Elements are compared with x in the promoted common type,
+                // into which the element type converts one to one: either
+                // x converts back to an element value, or no element equals x.
+                using C = decltype(needle + x);
+
+                if (static_cast<C>(needle) != static_cast<C>(x)) {
+                    if constexpr (Equal) {
+                        return last;
+                    } else {
+                        return first == last ? last : (Backward ? last - 1 : first);
+                    }
+                }
+            }
+
+            size_t index = Backward
+                ? simd::FindLast(data, count, needle, Equal)
+                : simd::Find(data, count, needle, Equal);
+
+            return first + static_cast<std::iter_difference_t<Iter>>(index);
+        }
+
+        // Contiguous ranges of integers or floats checked with the default
+        // comparator or predicate go to the SIMD kernels.
+        template<class Iter>
+        constexpr bool kSimdComparable = []() {
+            if constexpr (std::contiguous_iterator<Iter>) {
+                return simd::kFindable<std::iter_value_t<Iter>>;
+            } else {
+                return false;
+            }
+        }();
+
+        template<class Iter>
+        Iter simd_sorted_until(Iter first, Iter last) {
+            size_t index = simd::SortedUntil(std::to_address(first), static_cast<size_t>(last - first));
+
+            return first + static_cast<std::iter_difference_t<Iter>>(index);
+        }
+
+        template<class Iter>
+        Iter simd_palindrome_until(Iter first, Iter last) {
+            size_t index = simd::PalindromeUntil(std::to_address(first), static_cast<size_t>(last - first));
+
+            return first + static_cast<std::iter_difference_t<Iter>>(index);
+        }
+
+        // Over bits a predicate can only give two answers, so it is asked
+        // once for each and the bits are then counted or searched a word at
+        // a time.
+        template<
+            class Iter,
+            class Predicate
+        > constexpr bool kBitPredicate = kBitWords<Iter> && std::is_invocable_r_v<bool, Predicate&, bool>;
+
+        // How many bits of [first, last) satisfy p: the set ones, the clear
+        // ones, all or none of them.
+        template<
+            class Iter,
+            class Predicate
+        > size_t bit_matches(Iter first, Iter last, Predicate& p) {
+            bool on_set = p(true);
+            bool on_clear = p(false);
+            BitRange<Iter> range(first, last);
+
+            if (on_set == on_clear) {
+                return on_set ? range.last - range.first : 0;
+            }
+
+            size_t ones = range.count();
+
+            return on_set ? ones : range.last - range.first - ones;
+        }
+
+        // The first bit of [first, last) that does not satisfy p.
+        template<
+            class Iter,
+            class Predicate
+        > Iter bit_find_if_not(Iter first, Iter last, Predicate& p) {
+            bool on_set = p(true);
+            bool on_clear = p(false);
+
+            if (on_set && on_clear) {
+                return last;
+            }
+
+            if (!on_set && !on_clear) {
+                return first;
+            }
+
+            BitRange<Iter> range(first, last);
+
+            return first + static_cast<std::iter_difference_t<Iter>>(range.find(!on_set) - range.first);
+        }
+
+        // Sets of needles up to this size are searched linearly, larger
+        // ones by binary search.
+        constexpr size_t kLinearNeedles = 8;
+
+        template<class Needles>
+        using NeedleValue = std::remove_cvref_t<decltype(*std::begin(std::declval<const Needles&>()))>;
+
+        // Whether a needle of type N can equal an element of type V: integers
+        // of any types, floating-point types only when they are the same.
+        template<
+            typename V,
+            typename N
+        > constexpr bool kNeedlesConvert = std::is_integral_v<V>
+            ? std::is_integral_v<N> && !std::is_same_v<N, bool> && !std::is_same_v<V, bool>
+            : std::is_floating_point_v<V> && std::is_same_v<V, N>;
+
+        // The needle as an element value, or false when no element equals it
+        // (an integer out of range of V, or NaN).
+        template<
+            typename V,
+            typename N
+        > bool needle_value(const N& x, V& res) {
+            res = static_cast<V>(x);
+
+            if constexpr (std::is_integral_v<V>) {
+                using C = decltype(res + x);
+
+                return static_cast<C>(res) == static_cast<C>(x);
+            } else {
+                return res == res;
+            }
+        }
+
+        template<
+            typename V,
+            class Needles
+        > simd::ByteSet make_byte_set(const Needles& needles) {
+            simd::ByteSet res;
+            V value;
+
+            for (const auto& x : needles) {
+                if (needle_value(x, value)) {
+                    res.insert(static_cast<uint8_t>(value));
+                }
+            }
+
+            return res;
+        }
+
+        // The needles converted to element values, sorted and deduplicated.
+        template<typename V>
+        class NeedleSet {
+        public:
+            template<class Needles>
+            explicit NeedleSet(const Needles& needles) {
+                V value;
+
+                for (const auto& x : needles) {
+                    if (needle_value(x, value)) {
+                        values_.push_back(value);
+                    }
+                }
+
+                std::sort(values_.begin(), values_.end());
+                values_.erase(std::unique(values_.begin(), values_.end()), values_.end());
+            }
+
+            // Found by ==, not by equivalence under <, under which NaN would
+            // match any needle.
+            bool contains(const V& x) const {
+                if (values_.size() <= kLinearNeedles) {
+                    return std::find(values_.begin(), values_.end(), x) != values_.end();
+                }
+
+                auto it = std::lower_bound(values_.begin(), values_.end(), x);
+
+                return it != values_.end() && *it == x;
+            }
+        private:
+            std::vector<V> values_;
+        };
+
+        // The first element that is (with Member false, is not) equal to one
+        // of the needles, found through a lookup structure: byte elements in
+        // a 256-bit map, with vector kernels on contiguous ranges, other
+        // integers and floats in a sorted set.
+        template<
+            bool Member,
+            class Iter,
+            class Needles
+        > Iter find_any_of_lookup(Iter first, Iter last, const Needles& needles) {
+            using V = std::iter_value_t<Iter>;
+
+            if constexpr (sizeof(V) == 1) {
+                simd::ByteSet set = make_byte_set<V>(needles);
+
+                if constexpr (std::contiguous_iterator<Iter>) {
+                    const uint8_t* data = reinterpret_cast<const uint8_t*>(std::to_address(first));
+                    size_t index = simd::FindAnyOf(data, static_cast<size_t>(last - first), set, Member);
+
+                    return first + static_cast<std::iter_difference_t<Iter>>(index);
+                } else {
+                    for (; first != last; ++first) {
+                        if (set.contains(static_cast<uint8_t>(*first)) == Member) {
+                            break;
+                        }
+                    }
+
+                    return first;
+                }
+            } else {
+                NeedleSet<V> set(needles);
+
+                for (; first != last; ++first) {
+                    if (set.contains(*first) == Member) {
+                        break;
+                    }
+                }
+
+                return first;
+            }
+        }
+
+        // Anything else, and constant evaluation, compares every element
+        // with every needle.
+        template<
+            bool Member,
+            class Iter,
+            class Needles
+        > constexpr Iter find_any_of_base(Iter first, Iter last, const Needles& needles) {
+            if constexpr (kNeedlesConvert<std::iter_value_t<Iter>, NeedleValue<Needles>>) {
+                if (!std::is_constant_evaluated()) {
+                    return find_any_of_lookup<Member>(first, last, needles);
+                }
+            }
+
+            for (; first != last; ++first) {
+                bool found = false;
+
+                for (const auto& x : needles) {
+                    if (*first == x) {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (found == Member) {
+                    break;
+                }
+            }
+
+            return first;
+        }
+    };
+
     template<
         class InputIt,
         class Predicate,
@@ -165,31 +601,103 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > constexpr InputIt find_last(InputIt first, InputIt last, Predicate p) {
-        InputIt res = last;
+        return base::find_last_base(first, last, p, typename std::iterator_traits<InputIt>::iterator_category());
+    }
 
-        for (; first != last; ++first) {
-            if (p(*first)) {
-                res = first;
+    template<
+        class InputIt,
+        typename T,
+        typename = RequireInputIter<InputIt>
+    > constexpr InputIt find_not(InputIt first, InputIt last, const T& x) {
+        if constexpr (base::kBitWords<InputIt> && std::is_same_v<T, bool>) {
+            if (!std::is_constant_evaluated()) {
+                base::BitRange<InputIt> range(first, last);
+
+                return first + static_cast<std::iter_difference_t<InputIt>>(range.find(!x) - range.first);
+            }
+        }
+
+        if constexpr (base::kSimdFindable<InputIt, T>) {
+            if (!std::is_constant_evaluated()) {
+                return base::simd_find<false, false>(first, last, x);
             }
         }
 
-        return res;
+        return lab::find_if_not(first, last, base::BaseFindPredicate<T>(x));
     }
 
     template<
         class InputIt,
         typename T,
         typename = RequireInputIter<InputIt>
-    > constexpr InputIt find_not(InputIt first, InputIt last, T x) {
-        return lab::find_if_not(first, last, base::BaseFindPredicate<T>(x));
+    > constexpr InputIt find_backward(InputIt first, InputIt last, const T& x) {
+        if constexpr (base::kSimdFindable<InputIt, T>) {
+            if (!std::is_constant_evaluated()) {
+                return base::simd_find<true, true>(first, last, x);
+            }
+        }
+
+        return find_last(first, last, base::BaseFindPredicate<T>(x));
+    }
+
+    // The first element equal to any of the needles (a container, a
+    // string or string literal, or a braced list), or the first equal to
+    // none of them:
+    //
+    //     auto word_end = lab::find_any_of(it, text.end(), std::string_view(" \t\n,;"));
+    //     auto next_word = lab::find_not_any_of(word_end, text.end(), {' ', '\t', '\n'});
+    //
+    // The needles are read once, into a lookup structure, before the scan.
+    template<
+        class InputIt,
+        class Needles,
+        typename = RequireInputIter<InputIt>
+    > constexpr InputIt find_any_of(InputIt first, InputIt last, const Needles& needles) {
+        return base::find_any_of_base<true>(first, last, needles);
     }
 
     template<
         class InputIt,
         typename T,
         typename = RequireInputIter<InputIt>
-    > constexpr InputIt find_backward(InputIt first, InputIt last, T x) {
-        return find_last(first, last, base::BaseFindPredicate<T>(x));
+    > constexpr InputIt find_any_of(InputIt first, InputIt last, std::initializer_list<T> needles) {
+        return base::find_any_of_base<true>(first, last, needles);
+    }
+
+    template<
+        class InputIt,
+        typename CharT,
+        size_t N,
+        typename = RequireInputIter<InputIt>,
+        typename = RequireCharacter<CharT>
+    > constexpr InputIt find_any_of(InputIt first, InputIt last, const CharT (&needles)[N]) {
+        return base::find_any_of_base<true>(first, last, base::LiteralNeedles<CharT>(needles));
+    }
+
+    template<
+        class InputIt,
+        class Needles,
+        typename = RequireInputIter<InputIt>
+    > constexpr InputIt find_not_any_of(InputIt first, InputIt last, const Needles& needles) {
+        return base::find_any_of_base<false>(first, last, needles);
+    }
+
+    template<
+        class InputIt,
+        typename T,
+        typename = RequireInputIter<InputIt>
+    > constexpr InputIt find_not_any_of(InputIt first, InputIt last, std::initializer_list<T> needles) {
+        return base::find_any_of_base<false>(first, last, needles);
+    }
+
+    template<
+        class InputIt,
+        typename CharT,
+        size_t N,
+        typename = RequireInputIter<InputIt>,
+        typename = RequireCharacter<CharT>
+    > constexpr InputIt find_not_any_of(InputIt first, InputIt last, const CharT (&needles)[N]) {
+        return base::find_any_of_base<false>(first, last, base::LiteralNeedles<CharT>(needles));
     }
 
     template<
@@ -197,7 +705,13 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > constexpr bool all_of(InputIt first, InputIt last, Predicate p) {
-        return last == lab::find_if_not(first, last, p);
+        if constexpr (base::kBitPredicate<InputIt, Predicate>) {
+            if (!std::is_constant_evaluated()) {
+                return last == base::bit_find_if_not(first, last, p);
+            }
+        }
+
+        return last == lab::find_if_not<InputIt, Predicate&>(first, last, p);
     }
 
     template<
@@ -205,7 +719,17 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > constexpr bool none_of(InputIt first, InputIt last, Predicate p) {
-        return last == lab::find_if(first, last, p);
+        if constexpr (base::kBitPredicate<InputIt, Predicate>) {
+            if (!std::is_constant_evaluated()) {
+                auto q = [&p](bool bit) -> bool {
+                    return !p(bit);
+                };
+
+                return last == base::bit_find_if_not(first, last, q);
+            }
+        }
+
+        return last == lab::find_if<InputIt, Predicate&>(first, last, p);
     }
 
     template<
@@ -213,7 +737,7 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > constexpr bool any_of(InputIt first, InputIt last, Predicate p) {
-        return !lab::none_of(first, last, p);
+        return !lab::none_of<InputIt, Predicate&>(first, last, p);
     }
 
     template<
@@ -221,6 +745,12 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > constexpr bool one_of(InputIt first, InputIt last, Predicate p) {
+        if constexpr (base::kBitPredicate<InputIt, Predicate>) {
+            if (!std::is_constant_evaluated()) {
+                return base::bit_matches(first, last, p) == 1;
+            }
+        }
+
         bool exist = false;
 
         for (; first != last; ++first) {
@@ -240,6 +770,12 @@ namespace lab {
         class ForwardIt,
         typename = RequireFwdIter<ForwardIt>
     > constexpr bool is_sorted(ForwardIt first, ForwardIt last) {
+        if constexpr (base::kSimdComparable<ForwardIt>) {
+            if (!std::is_constant_evaluated()) {
+                return base::simd_sorted_until(first, last) == last;
+            }
+        }
+
         return base::is_sorted_base(first, last, base::BaseComparator());
     }
 
@@ -248,7 +784,7 @@ namespace lab {
         class Compare,
         typename = RequireFwdIter<ForwardIt>
     > constexpr bool is_sorted(ForwardIt first, ForwardIt last, Compare compare) {
-        return base::is_sorted_base(first, last, IteratorComparator(compare));
+        return base::is_sorted_base(first, last, IteratorComparator<Compare&>(compare));
     }
 
     template<
@@ -286,6 +822,11 @@ namespace lab {
             if (!p(*first, *prev)) {
                 return false;
             }
+
+            // Even length: the ends meet without ever being equal.
+            if (std::next(first) == prev) {
+                break;
+            }
         }
 
         return true;
@@ -295,9 +836,97 @@ namespace lab {
         class BidirIt,
         typename = RequireBidirIter<BidirIt>
     > constexpr bool is_palindrome(BidirIt first, BidirIt last) {
+        if constexpr (base::kSimdComparable<BidirIt>) {
+            if (!std::is_constant_evaluated()) {
+                return base::simd_palindrome_until(first, last) == last;
+            }
+        }
+
         return is_palindrome(first, last, base::BasePalindromePredicate());
     }
 
+    // The *_until forms return the first element that breaks the property,
+    // last if there is none: the element that is out of order, the one
+    // satisfying p after the partition point, or the first element (from
+    // the front) that differs from its mirror.
+    template<
+        class ForwardIt,
+        typename = RequireFwdIter<ForwardIt>
+    > constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+        if constexpr (base::kSimdComparable<ForwardIt>) {
+            if (!std::is_constant_evaluated()) {
+                return base::simd_sorted_until(first, last);
+            }
+        }
+
+        return base::is_sorted_until_base(first, last, base::BaseComparator());
+    }
+
+    template<
+        class ForwardIt,
+        class Compare,
+        typename = RequireFwdIter<ForwardIt>
+    > constexpr ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare compare) {
+        return base::is_sorted_until_base(first, last, IteratorComparator<Compare&>(compare));
+    }
+
+    template<
+        class InputIt,
+        class Predicate,
+        typename = RequireInputIter<InputIt>
+    > constexpr InputIt is_partitioned_until(InputIt first, InputIt last, Predicate p) {
+        for (; first != last; ++first) {
+            if (!p(*first)) {
+                break;
+            }
+        }
+
+        for (; first != last; ++first) {
+            if (p(*first)) {
+                return first;
+            }
+        }
+
+        return last;
+    }
+
+    template<
+        class BidirIt,
+        class Predicate,
+        typename = RequireBidirIter<BidirIt>
+    > constexpr BidirIt is_palindrome_until(BidirIt first, BidirIt last, Predicate p) {
+        if (first == last) {
+            return last;
+        }
+
+        BidirIt prev = last;
+
+        for (--prev; first != prev; ++first, --prev) {
+            if (!p(*first, *prev)) {
+                return first;
+            }
+
+            if (std::next(first) == prev) {
+                break;
+            }
+        }
+
+        return last;
+    }
+
+    template<
+        class BidirIt,
+        typename = RequireBidirIter<BidirIt>
+    > constexpr BidirIt is_palindrome_until(BidirIt first, BidirIt last) {
+        if constexpr (base::kSimdComparable<BidirIt>) {
+            if (!std::is_constant_evaluated()) {
+                return base::simd_palindrome_until(first, last);
+            }
+        }
+
+        return lab::is_palindrome_until(first, last, base::BasePalindromePredicate());
+    }
+
 #elif __cplusplus >= 201103L
 
     template<
@@ -333,31 +962,100 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > InputIt find_last(InputIt first, InputIt last, Predicate p) {
-        InputIt res = last;
+        return base::find_last_base(first, last, p, typename std::iterator_traits<InputIt>::iterator_category());
+    }
 
-        for (; first != last; ++first) {
-            if (p(*first)) {
-                res = first;
+    template<
+        class InputIt,
+        typename T,
+        typename = RequireInputIter<InputIt>
+    > InputIt find_not(InputIt first, InputIt last, const T& x) {
+        return lab::find_if_not(first, last, base::BaseFindPredicate<T>(x));
+    }
+
+    template<
+        class InputIt,
+        typename T,
+        typename = RequireInputIter<InputIt>
+    > InputIt find_backward(InputIt first, InputIt last, const T& x) {
+        return find_last(first, last, base::BaseFindPredicate<T>(x));
+    }
+
+    namespace base {
+        template<
+            bool Member,
+            class InputIt,
+            class Needles
+        > InputIt find_any_of_base(InputIt first, InputIt last, const Needles& needles) {
+            for (; first != last; ++first) {
+                bool found = false;
+
+                for (const auto& x : needles) {
+                    if (*first == x) {
+                        found = true;
+                        break;
+                    }
+                }
+
+                if (found == Member) {
+                    break;
+                }
             }
+
+            return first;
         }
+    };
 
-        return res;
+    template<
+        class InputIt,
+        class Needles,
+        typename = RequireInputIter<InputIt>
+    > InputIt find_any_of(InputIt first, InputIt last, const Needles& needles) {
+        return base::find_any_of_base<true>(first, last, needles);
     }
 
     template<
         class InputIt,
         typename T,
         typename = RequireInputIter<InputIt>
-    > InputIt find_not(InputIt first, InputIt last, T x) {
-        return lab::find_if_not(first, last, base::BaseFindPredicate<T>(x));
+    > InputIt find_any_of(InputIt first, InputIt last, std::initializer_list<T> needles) {
+        return base::find_any_of_base<true>(first, last, needles);
+    }
+
+    template<
+        class InputIt,
+        typename CharT,
+        size_t N,
+        typename = RequireInputIter<InputIt>,
+        typename = RequireCharacter<CharT>
+    > InputIt find_any_of(InputIt first, InputIt last, const CharT (&needles)[N]) {
+        return base::find_any_of_base<true>(first, last, base::LiteralNeedles<CharT>(needles));
+    }
+
+    template<
+        class InputIt,
+        class Needles,
+        typename = RequireInputIter<InputIt>
+    > InputIt find_not_any_of(InputIt first, InputIt last, const Needles& needles) {
+        return base::find_any_of_base<false>(first, last, needles);
     }
 
     template<
         class InputIt,
         typename T,
         typename = RequireInputIter<InputIt>
-    > InputIt find_backward(InputIt first, InputIt last, T x) {
-        return find_last(first, last, base::BaseFindPredicate<T>(x));
+    > InputIt find_not_any_of(InputIt first, InputIt last, std::initializer_list<T> needles) {
+        return base::find_any_of_base<false>(first, last, needles);
+    }
+
+    template<
+        class InputIt,
+        typename CharT,
+        size_t N,
+        typename = RequireInputIter<InputIt>,
+        typename = RequireCharacter<CharT>
+    > InputIt find_not_any_of(InputIt first, InputIt last, const CharT (&needles)[N]) {
+        return base::find_any_of_base<false>(first, last, base::LiteralNeedles<CharT>(needles));
     }
 
     template<
@@ -365,7 +1063,7 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > bool all_of(InputIt first, InputIt last, Predicate p) {
-        return last == lab::find_if_not(first, last, p);
+        return last == lab::find_if_not<InputIt, Predicate&>(first, last, p);
     }
 
     template<
@@ -373,7 +1071,7 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > bool none_of(InputIt first, InputIt last, Predicate p) {
-        return last == lab::find_if(first, last, p);
+        return last == lab::find_if<InputIt, Predicate&>(first, last, p);
     }
 
     template<
@@ -381,7 +1079,7 @@ namespace lab {
         class Predicate,
         typename = RequireInputIter<InputIt>
     > bool any_of(InputIt first, InputIt last, Predicate p) {
-        return !lab::none_of(first, last, p);
+        return !lab::none_of<InputIt, Predicate&>(first, last, p);
     }
 
     template<
@@ -416,7 +1114,7 @@ namespace lab {
         class Compare,
         typename = RequireFwdIter<ForwardIt>
     > bool is_sorted(ForwardIt first, ForwardIt last, Compare compare) {
-        return base::is_sorted_base(first, last, IteratorComparator(compare));
+        return base::is_sorted_base(first, last, IteratorComparator<Compare&>(compare));
     }
 
     template<
@@ -454,6 +1152,11 @@ namespace lab {
             if (!p(*first, *prev)) {
                 return false;
             }
+
+            // Even length: the ends meet without ever being equal.
+            if (std::next(first) == prev) {
+                break;
+            }
         }
 
         return true;
@@ -466,5 +1169,75 @@ namespace lab {
         return is_palindrome(first, last, base::BasePalindromePredicate());
     }
 
+    // The *_until forms return the first element that breaks the property,
+    // last if there is none: the element that is out of order, the one
+    // satisfying p after the partition point, or the first element (from
+    // the front) that differs from its mirror.
+    template<
+        class ForwardIt,
+        typename = RequireFwdIter<ForwardIt>
+    > ForwardIt is_sorted_until(ForwardIt first, ForwardIt last) {
+        return base::is_sorted_until_base(first, last, base::BaseComparator());
+    }
+
+    template<
+        class ForwardIt,
+        class Compare,
+        typename = RequireFwdIter<ForwardIt>
+    > ForwardIt is_sorted_until(ForwardIt first, ForwardIt last, Compare compare) {
+        return base::is_sorted_until_base(first, last, IteratorComparator<Compare&>(compare));
+    }
+
+    template<
+        class InputIt,
+        class Predicate,
+        typename = RequireInputIter<InputIt>
+    > InputIt is_partitioned_until(InputIt first, InputIt last, Predicate p) {
+        for (; first != last; ++first) {
+            if (!p(*first)) {
+                break;
+            }
+        }
+
+        for (; first != last; ++first) {
+            if (p(*first)) {
+                return first;
+            }
+        }
+
+        return last;
+    }
+
+    template<
+        class BidirIt,
+        class Predicate,
+        typename = RequireBidirIter<BidirIt>
+    > BidirIt is_palindrome_until(BidirIt first, BidirIt last, Predicate p) {
+        if (first == last) {
+            return last;
+        }
+
+        BidirIt prev = last;
+
+        for (--prev; first != prev; ++first, --prev) {
+            if (!p(*first, *prev)) {
+                return first;
+            }
+
+            if (std::next(first) == prev) {
+                break;
+            }
+        }
+
+        return last;
+    }
+
+    template<
+        class BidirIt,
+        typename = RequireBidirIter<BidirIt>
+    > BidirIt is_palindrome_until(BidirIt first, BidirIt last) {
+        return lab::is_palindrome_until(first, last, base::BasePalindromePredicate());
+    }
+
 #endif
 };
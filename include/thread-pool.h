@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace lab {
+    // Work-stealing pool: every worker owns a deque, pushes and pops its own
+    // tasks at the back and steals from the front of the others, so large
+    // pieces of split work migrate to idle threads first.
+    class ThreadPool {
+    public:
+        using Task = std::function<void()>;
+    public:
+        explicit ThreadPool(size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+            threads = std::max<size_t>(1, threads);
+
+            for (size_t i = 0; i < threads; ++i) {
+                queues_.push_back(std::make_unique<Queue>());
+            }
+
+            for (size_t i = 0; i < threads; ++i) {
+                workers_.emplace_back([this, i] {
+                    WorkerLoop(i);
+                });
+            }
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        ~ThreadPool() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+
+            wake_.notify_all();
+
+            for (auto& worker : workers_) {
+                worker.join();
+            }
+        }
+    public:
+        // Tasks must not throw; use TaskGroup to collect exceptions.
+        void Submit(Task task) {
+            size_t index = CurrentWorker().first == this
+                ? CurrentWorker().second
+                : next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+
+            {
+                std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+                queues_[index]->tasks.push_back(std::move(task));
+            }
+
+            pending_.fetch_add(1, std::memory_order_release);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+            }
+
+            wake_.notify_one();
+        }
+
+        // Runs one queued task on the calling thread, if there is any. Lets
+        // threads that wait for their tasks help instead of blocking.
+        bool RunPendingTask() {
+            size_t index = CurrentWorker().first == this ? CurrentWorker().second : 0;
+            Task task;
+
+            if (!PopTask(index, task)) {
+                return false;
+            }
+
+            task();
+
+            return true;
+        }
+
+        size_t Size() const {
+            return workers_.size();
+        }
+    private:
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::atomic<size_t> pending_{0};
+        std::atomic<size_t> next_queue_{0};
+        bool stop_ = false;
+    private:
+        static std::pair<ThreadPool*, size_t>& CurrentWorker() {
+            static thread_local std::pair<ThreadPool*, size_t> current{nullptr, 0};
+
+            return current;
+        }
+
+        void WorkerLoop(size_t index) {
+            CurrentWorker() = {this, index};
+
+            while (true) {
+                Task task;
+
+                if (PopTask(index, task)) {
+                    task();
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex_);
+
+                wake_.wait(lock, [this] {
+                    return stop_ || pending_.load(std::memory_order_acquire) > 0;
+                });
+
+                if (stop_ && pending_.load(std::memory_order_acquire) == 0) {
+                    return;
+                }
+            }
+        }
+
+        bool PopTask(size_t index, Task& task) {
+            {
+                Queue& own = *queues_[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+
+                if (!own.tasks.empty()) {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+                    return true;
+                }
+            }
+
+            for (size_t i = 1; i < queues_.size(); ++i) {
+                Queue& victim = *queues_[(index + i) % queues_.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+
+                if (!victim.tasks.empty()) {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    pending_.fetch_sub(1, std::memory_order_relaxed);
+
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    };
+
+    inline ThreadPool& DefaultThreadPool() {
+        static ThreadPool pool;
+
+        return pool;
+    }
+
+    // A set of tasks that is waited for as a whole. The first exception
+    // thrown by a task cancels the group and is rethrown from Wait().
+    class TaskGroup {
+    public:
+        explicit TaskGroup(ThreadPool& pool = DefaultThreadPool())
+            : pool_(pool)
+        {}
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        ~TaskGroup() {
+            WaitAll();
+        }
+    public:
+        template<typename Function>
+        void Run(Function task) {
+            outstanding_.fetch_add(1, std::memory_order_relaxed);
+
+            pool_.Submit([this, task = std::move(task)]() mutable {
+                if (!IsCancelled()) {
+                    try {
+                        task();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(mutex_);
+
+                        if (!exception_) {
+                            exception_ = std::current_exception();
+                        }
+
+                        cancelled_.store(true, std::memory_order_relaxed);
+                    }
+                }
+
+                // Decrement under the lock: once the waiter sees zero it may
+                // destroy the group, which must not happen while we still
+                // touch it.
+                std::lock_guard<std::mutex> lock(mutex_);
+
+                if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    done_.notify_all();
+                }
+            });
+        }
+
+        void Wait() {
+            WaitAll();
+
+            if (exception_) {
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+            }
+        }
+
+        void Cancel() {
+            cancelled_.store(true, std::memory_order_relaxed);
+        }
+
+        bool IsCancelled() const {
+            return cancelled_.load(std::memory_order_relaxed);
+        }
+
+        ThreadPool& Pool() const {
+            return pool_;
+        }
+    private:
+        ThreadPool& pool_;
+        std::atomic<size_t> outstanding_{0};
+        std::atomic<bool> cancelled_{false};
+        std::mutex mutex_;
+        std::condition_variable done_;
+        std::exception_ptr exception_;
+    private:
+        void WaitAll() {
+            while (outstanding_.load(std::memory_order_acquire) > 0) {
+                if (pool_.RunPendingTask()) {
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(mutex_);
+
+                // Wake up now and then: running tasks may queue more work
+                // that this thread can help with.
+                done_.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                    return outstanding_.load(std::memory_order_acquire) == 0;
+                });
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+        }
+    };
+};
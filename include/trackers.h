@@ -0,0 +1,210 @@
+#pragma once
+
+#include "stl-algorithms.h"
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace lab {
+    namespace base {
+        template<
+            typename T,
+            class Compare
+        > constexpr bool kDefaultLess = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>>;
+    };
+
+    // Whether a growing sequence is sorted, in the sense of lab::is_sorted
+    // (comp holds for every adjacent pair), kept up to date as elements are
+    // appended. Each element costs one comparison; the answer and the
+    // position of the first element out of order are read in O(1):
+    //
+    //     lab::sorted_tracker<int64_t> order;
+    //     for (auto& batch : stream) {
+    //         order.append(batch.begin(), batch.end());
+    //     }
+    //     if (!order.is_sorted()) ... order.sorted_until() ...
+    //
+    // Only the last element is kept, and only while the sequence is sorted.
+    template<
+        typename T,
+        class Compare = std::less<>
+    > class sorted_tracker {
+    public:
+        sorted_tracker() = default;
+
+        explicit sorted_tracker(Compare comp)
+            : comp_(std::move(comp))
+        {}
+    public:
+        void push(const T& x) {
+            if (until_ == size_ && (!last_.has_value() || comp_(*last_, x))) {
+                ++until_;
+                last_ = x;
+            }
+
+            ++size_;
+        }
+
+        // The batch is checked with lab::is_sorted_until while the sequence
+        // is still sorted, so that contiguous arithmetic batches in the
+        // default order take the vector kernels.
+        template<
+            class InputIt,
+            typename = RequireInputIter<InputIt>
+        > void append(InputIt first, InputIt last) {
+            if constexpr (std::is_convertible_v<typename std::iterator_traits<InputIt>::iterator_category, std::forward_iterator_tag>) {
+                if (first == last) {
+                    return;
+                }
+
+                if (until_ == size_ && (!last_.has_value() || comp_(*last_, *first))) {
+                    InputIt until = FindUnsorted(first, last);
+                    size_t count = static_cast<size_t>(std::distance(first, last));
+
+                    until_ = size_ + static_cast<size_t>(std::distance(first, until));
+                    size_ += count;
+
+                    if (until_ == size_) {
+                        last_ = *std::next(first, static_cast<std::iter_difference_t<InputIt>>(count - 1));
+                    }
+
+                    return;
+                }
+            }
+
+            for (; first != last; ++first) {
+                push(*first);
+            }
+        }
+
+        template<class Range>
+        void append(const Range& range) {
+            append(std::begin(range), std::end(range));
+        }
+
+        bool is_sorted() const {
+            return until_ == size_;
+        }
+
+        // The position of the first element that is not in order after the
+        // one before it, size() if there is none.
+        size_t sorted_until() const {
+            return until_;
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        void clear() {
+            last_.reset();
+            size_ = 0;
+            until_ = 0;
+        }
+    private:
+        Compare comp_;
+
+        // The last element, while the sequence is sorted; after the first
+        // violation it is no longer needed and stops being updated.
+        std::optional<T> last_;
+        size_t size_ = 0;
+
+        // Equal to size_ while the sequence is sorted, so that it follows
+        // the size until the first violation and then stays put.
+        size_t until_ = 0;
+    private:
+        template<class ForwardIt>
+        ForwardIt FindUnsorted(ForwardIt first, ForwardIt last) {
+            if constexpr (base::kDefaultLess<T, Compare>) {
+                return lab::is_sorted_until(first, last);
+            } else {
+                return lab::is_sorted_until(first, last, std::ref(comp_));
+            }
+        }
+    };
+
+    // Whether a growing sequence is partitioned by p, in the sense of
+    // lab::is_partitioned (every element satisfying p comes before every
+    // element that does not), kept up to date as elements are appended.
+    // Each element costs one call of p; the answer, the partition point and
+    // the first element breaking the partition are read in O(1). No
+    // elements are kept.
+    template<
+        typename T,
+        class Predicate
+    > class partition_tracker {
+    public:
+        partition_tracker() = default;
+
+        explicit partition_tracker(Predicate p)
+            : p_(std::move(p))
+        {}
+    public:
+        void push(const T& x) {
+            if (until_ == size_) {
+                bool matches = p_(x);
+
+                if (point_ == size_ && matches) {
+                    ++point_;
+                    ++until_;
+                } else if (!matches) {
+                    ++until_;
+                }
+            }
+
+            ++size_;
+        }
+
+        template<
+            class InputIt,
+            typename = RequireInputIter<InputIt>
+        > void append(InputIt first, InputIt last) {
+            for (; first != last; ++first) {
+                push(*first);
+            }
+        }
+
+        template<class Range>
+        void append(const Range& range) {
+            append(std::begin(range), std::end(range));
+        }
+
+        bool is_partitioned() const {
+            return until_ == size_;
+        }
+
+        // The position of the first element satisfying p after one that does
+        // not, size() if there is none.
+        size_t partitioned_until() const {
+            return until_;
+        }
+
+        // The position of the first element that does not satisfy p, size()
+        // if there is none.
+        size_t partition_point() const {
+            return point_;
+        }
+
+        size_t size() const {
+            return size_;
+        }
+
+        void clear() {
+            size_ = 0;
+            point_ = 0;
+            until_ = 0;
+        }
+    private:
+        Predicate p_;
+        size_t size_ = 0;
+
+        // Both follow the size while their condition holds: every element
+        // so far satisfies p, and the sequence is partitioned.
+        size_t point_ = 0;
+        size_t until_ = 0;
+    };
+};
@@ -0,0 +1,379 @@
+#pragma once
+
+#include "xrange.h"
+
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <iterator>
+
+namespace lab {
+    // Walks a box of per-dimension xrange indices [lo, hi) in row-major
+    // order, the last dimension changing fastest.
+    template<
+        typename T,
+        size_t N
+    > class XRangeNdIterator {
+    public:
+        using value_type        = std::array<T, N>;
+        using reference         = value_type;
+        using pointer           = void;
+        using difference_type   = ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+    public:
+        XRangeNdIterator() = default;
+
+        XRangeNdIterator(
+            const std::array<xrange<T>, N>* ranges,
+            const std::array<size_t, N>& lo,
+            const std::array<size_t, N>& hi,
+            const std::array<size_t, N>& position
+        )
+            : ranges_(ranges)
+            , lo_(lo)
+            , hi_(hi)
+            , position_(position)
+        {}
+    public:
+        bool operator==(const XRangeNdIterator& other) const {
+            return position_ == other.position_;
+        }
+
+        bool operator!=(const XRangeNdIterator& other) const {
+            return !(*this == other);
+        }
+
+        value_type operator*() const {
+            value_type res;
+
+            for (size_t d = 0; d < N; ++d) {
+                res[d] = (*ranges_)[d][position_[d]];
+            }
+
+            return res;
+        }
+
+        XRangeNdIterator& operator++() {
+            for (size_t d = N - 1; d > 0; --d) {
+                if (++position_[d] < hi_[d]) {
+                    return *this;
+                }
+
+                position_[d] = lo_[d];
+            }
+
+            ++position_[0];
+
+            return *this;
+        }
+
+        XRangeNdIterator operator++(int) {
+            XRangeNdIterator res = *this;
+            ++(*this);
+
+            return res;
+        }
+    private:
+        const std::array<xrange<T>, N>* ranges_ = nullptr;
+        std::array<size_t, N> lo_{};
+        std::array<size_t, N> hi_{};
+        std::array<size_t, N> position_{};
+    };
+
+    // Cartesian product of N xranges, yielding std::array<T, N> index tuples:
+    //
+    //     for (auto [i, j] : lab::xrange_nd(lab::xrange(h), lab::xrange(w)))
+    template<
+        typename T,
+        size_t N
+    > class xrange_nd {
+    public:
+        using value_type      = std::array<T, N>;
+        using iterator        = XRangeNdIterator<T, N>;
+        using difference_type = ptrdiff_t;
+        using size_type       = size_t;
+    public:
+        template<typename... Ranges>
+        xrange_nd(const xrange<T>& range, const Ranges&... ranges)
+            : ranges_{range, ranges...}
+        {
+            static_assert(sizeof...(Ranges) + 1 == N, "xrange_nd needs exactly N ranges");
+
+            for (size_t d = 0; d < N; ++d) {
+                hi_[d] = ranges_[d].size();
+            }
+        }
+
+        // The sub-box of per-dimension element indices [lo, hi).
+        xrange_nd(const std::array<xrange<T>, N>& ranges, const std::array<size_t, N>& lo, const std::array<size_t, N>& hi)
+            : ranges_(ranges)
+            , lo_(lo)
+            , hi_(hi)
+        {}
+    public:
+        iterator begin() const {
+            return iterator(&ranges_, lo_, hi_, empty() ? EndPosition() : lo_);
+        }
+
+        iterator end() const {
+            return iterator(&ranges_, lo_, hi_, EndPosition());
+        }
+
+        size_type size() const {
+            size_type res = 1;
+
+            for (size_t d = 0; d < N; ++d) {
+                res *= extent(d);
+            }
+
+            return res;
+        }
+
+        bool empty() const {
+            return size() == 0;
+        }
+
+        size_type extent(size_t d) const {
+            return hi_[d] - lo_[d];
+        }
+
+        const std::array<xrange<T>, N>& ranges() const {
+            return ranges_;
+        }
+
+        const std::array<size_t, N>& lower() const {
+            return lo_;
+        }
+
+        const std::array<size_t, N>& upper() const {
+            return hi_;
+        }
+    private:
+        std::array<xrange<T>, N> ranges_;
+        std::array<size_t, N> lo_{};
+        std::array<size_t, N> hi_{};
+    private:
+        std::array<size_t, N> EndPosition() const {
+            std::array<size_t, N> res = lo_;
+            res[0] = hi_[0];
+
+            return res;
+        }
+    };
+
+    template<
+        typename T,
+        typename... Ranges
+    > xrange_nd(const xrange<T>&, const Ranges&...) -> xrange_nd<T, sizeof...(Ranges) + 1>;
+
+    enum class tile_order {
+        // Tiles row-major, like a blocked nested loop.
+        blocked,
+        // Tiles along the Z-order curve, keeping consecutive tiles close in
+        // every dimension.
+        morton
+    };
+
+    template<
+        typename T,
+        size_t N
+    > class tiled_xrange;
+
+    template<
+        typename T,
+        size_t N
+    > class TiledXRangeIterator {
+    public:
+        using value_type        = std::array<T, N>;
+        using reference         = value_type;
+        using pointer           = void;
+        using difference_type   = ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+    public:
+        TiledXRangeIterator() = default;
+
+        TiledXRangeIterator(const tiled_xrange<T, N>* range, size_t tile)
+            : range_(range)
+            , tile_(tile)
+        {
+            SkipEmptyTiles();
+        }
+    public:
+        bool operator==(const TiledXRangeIterator& other) const {
+            return tile_ == other.tile_ && (tile_ == range_->tile_count() || inner_ == other.inner_);
+        }
+
+        bool operator!=(const TiledXRangeIterator& other) const {
+            return !(*this == other);
+        }
+
+        value_type operator*() const {
+            return *inner_;
+        }
+
+        TiledXRangeIterator& operator++() {
+            if (++inner_ == inner_end_) {
+                ++tile_;
+                SkipEmptyTiles();
+            }
+
+            return *this;
+        }
+
+        TiledXRangeIterator operator++(int) {
+            TiledXRangeIterator res = *this;
+            ++(*this);
+
+            return res;
+        }
+    private:
+        const tiled_xrange<T, N>* range_ = nullptr;
+        size_t tile_ = 0;
+        XRangeNdIterator<T, N> inner_;
+        XRangeNdIterator<T, N> inner_end_;
+    private:
+        void SkipEmptyTiles() {
+            for (; tile_ < range_->tile_count(); ++tile_) {
+                xrange_nd<T, N> box = range_->tile(tile_);
+
+                if (!box.empty()) {
+                    // The box is a temporary: point at the ranges owned by
+                    // the tiled range instead.
+                    std::array<size_t, N> end = box.lower();
+                    end[0] = box.upper()[0];
+
+                    inner_ = XRangeNdIterator<T, N>(&range_->range().ranges(), box.lower(), box.upper(), box.lower());
+                    inner_end_ = XRangeNdIterator<T, N>(&range_->range().ranges(), box.lower(), box.upper(), end);
+
+                    return;
+                }
+            }
+        }
+    };
+
+    // Visits an xrange_nd tile by tile: all indices of one tile, row-major,
+    // before any index of the next, so a tile's working set stays in cache.
+    // Tiles can be taken apart with tile_count() and tile(k), e.g. to hand
+    // them to parallel_for.
+    template<
+        typename T,
+        size_t N
+    > class tiled_xrange {
+    public:
+        using value_type      = std::array<T, N>;
+        using iterator        = TiledXRangeIterator<T, N>;
+        using difference_type = ptrdiff_t;
+        using size_type       = size_t;
+    public:
+        tiled_xrange(const xrange_nd<T, N>& range, const std::array<size_t, N>& tile, tile_order order = tile_order::blocked)
+            : range_(range)
+            , tile_(tile)
+            , order_(order)
+        {
+            for (size_t d = 0; d < N; ++d) {
+                tile_[d] = std::max<size_t>(1, tile_[d]);
+                grid_[d] = (range_.extent(d) + tile_[d] - 1) / tile_[d];
+                count_ *= grid_[d];
+
+                while ((size_t(1) << bits_) < grid_[d]) {
+                    ++bits_;
+                }
+            }
+        }
+    public:
+        iterator begin() const {
+            return iterator(this, 0);
+        }
+
+        iterator end() const {
+            return iterator(this, tile_count());
+        }
+
+        size_type size() const {
+            return range_.size();
+        }
+
+        bool empty() const {
+            return range_.empty();
+        }
+
+        size_type tile_count() const {
+            return count_;
+        }
+
+        const xrange_nd<T, N>& range() const {
+            return range_;
+        }
+
+        // The k-th tile in traversal order.
+        xrange_nd<T, N> tile(size_type k) const {
+            std::array<size_t, N> coords = TileCoords(k);
+            std::array<size_t, N> lo;
+            std::array<size_t, N> hi;
+
+            for (size_t d = 0; d < N; ++d) {
+                lo[d] = range_.lower()[d] + coords[d] * tile_[d];
+                hi[d] = std::min(lo[d] + tile_[d], range_.upper()[d]);
+            }
+
+            return xrange_nd<T, N>(range_.ranges(), lo, hi);
+        }
+    private:
+        xrange_nd<T, N> range_;
+        std::array<size_t, N> tile_;
+        tile_order order_;
+
+        // Tiles per dimension, their product, and the number of bits of the
+        // largest tile coordinate.
+        std::array<size_t, N> grid_{};
+        size_t count_ = 1;
+        size_t bits_ = 0;
+    private:
+        // Tile coordinates of the k-th tile, computed on the spot so that
+        // the range stays O(N) in size however many tiles it has.
+        std::array<size_t, N> TileCoords(size_t k) const {
+            std::array<size_t, N> coords{};
+
+            if (order_ == tile_order::blocked) {
+                for (size_t d = N; d-- > 0;) {
+                    coords[d] = k % grid_[d];
+                    k /= grid_[d];
+                }
+
+                return coords;
+            }
+
+            // Z-order interleaves coordinate bits, the last dimension in the
+            // lowest bit. The grid is padded to a power of two per side and
+            // descended one bit at a time: of the 2^N sub-blocks, in curve
+            // order, k lands in the one where fewer tiles of the grid lie
+            // before it than k, so blocks outside the grid are never counted.
+            for (size_t level = bits_; level-- > 0;) {
+                size_t side = size_t(1) << level;
+
+                for (size_t child = 0; child < (size_t(1) << N); ++child) {
+                    size_t count = 1;
+
+                    for (size_t d = 0; d < N; ++d) {
+                        size_t from = coords[d] + ((child >> (N - 1 - d)) & 1) * side;
+
+                        count *= from < grid_[d] ? std::min(side, grid_[d] - from) : 0;
+                    }
+
+                    if (k < count) {
+                        for (size_t d = 0; d < N; ++d) {
+                            coords[d] += ((child >> (N - 1 - d)) & 1) * side;
+                        }
+
+                        break;
+                    }
+
+                    k -= count;
+                }
+            }
+
+            return coords;
+        }
+    };
+};
@@ -1,78 +1,360 @@
 #pragma once
 
+#include "simd.h"
+#include "stl-algorithms.h"
+
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <cstddef>
 #include <iterator>
+#include <limits>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Defined where the fma builtins fold in constant expressions, so that
+// LAB_XRANGE_USE_FMA values can be computed at compile time.
+#if defined(__GNUC__) && !defined(__clang__)
+#define LAB_XRANGE_CONSTEXPR_FMA
+#endif
 
 namespace lab {
+    namespace base {
+        // std::fma that gives the same, single-rounding result in constant
+        // evaluation. Without LAB_XRANGE_CONSTEXPR_FMA a constant evaluation
+        // fails to compile rather than round twice.
+        template<typename T>
+        constexpr T xrange_fma(T a, T b, T c) {
+#if defined(LAB_XRANGE_CONSTEXPR_FMA)
+            if constexpr (std::is_same_v<T, float>) {
+                return __builtin_fmaf(a, b, c);
+            } else if constexpr (std::is_same_v<T, double>) {
+                return __builtin_fma(a, b, c);
+            } else {
+                return __builtin_fmal(a, b, c);
+            }
+#else
+            if (std::is_constant_evaluated()) {
+                throw std::logic_error("fma cannot be evaluated at compile time by this compiler.");
+            }
+
+            return std::fma(a, b, c);
+#endif
+        }
+
+        template<
+            typename T,
+            typename Diff
+        > constexpr T xrange_value(T start, T step, Diff index) {
+            if constexpr (std::is_integral_v<T>) {
+                // Wrapping unsigned arithmetic: the true value always fits in T,
+                // intermediate products may not. The unsigned type is no wider
+                // than promoted T, so the loop counter can be narrowed and the
+                // loop vectorized as a plain induction variable.
+                using U = std::make_unsigned_t<std::common_type_t<T, int>>;
+
+                return static_cast<T>(
+                    static_cast<U>(start) + static_cast<U>(index) * static_cast<U>(step)
+                );
+            } else {
+#if defined(LAB_XRANGE_USE_FMA)
+                return xrange_fma(static_cast<T>(index), step, start);
+#else
+                return start + static_cast<T>(index) * step;
+#endif
+            }
+        }
+
+        template<typename T>
+        constexpr bool xrange_before_end(T value, T end, T step) {
+            return step > 0 ? value < end : value > end;
+        }
+
+        template<typename T>
+        constexpr bool xrange_end_overflows(T start, T step, size_t size) {
+            if constexpr (std::is_integral_v<T>) {
+                if (size == 0) {
+                    return false;
+                }
+
+                T last = xrange_value(start, step, size - 1);
+
+                if (step > 0) {
+                    return last > std::numeric_limits<T>::max() - step;
+                }
+
+                return last < std::numeric_limits<T>::min() - step;
+            } else {
+                return false;
+            }
+        }
+
+        template<typename T>
+        constexpr size_t xrange_size(T start, T end, T step) {
+            if constexpr (std::is_integral_v<T>) {
+                using U = std::uintmax_t;
+
+                U count = 0;
+
+                if (step > 0 && start < end) {
+                    count = (U(end) - U(start) - 1) / U(step) + 1;
+                } else if (step < 0 && start > end) {
+                    count = (U(start) - U(end) - 1) / (U(0) - U(step)) + 1;
+                }
+
+                // Iterators count positions in ptrdiff_t, so longer ranges,
+                // like xrange<uint64_t>(0, UINT64_MAX), cannot be walked.
+                if (count > U(PTRDIFF_MAX)) {
+                    throw std::runtime_error("xrange is too long.");
+                }
+
+                return static_cast<size_t>(count);
+            } else {
+                T count = (end - start) / step;
+
+                if (!(count > 0)) {
+                    return 0;
+                }
+
+                if (!(count < static_cast<T>(PTRDIFF_MAX / 2))) {
+                    throw std::runtime_error("xrange is too long.");
+                }
+
+                // The quotient above is rounded, so it is only a guess. Values
+                // start + i * step are monotonic in i, so the exact count is the
+                // first index whose value is not before end: gallop from the
+                // guess to bracket it, then bisect.
+                size_t guess = static_cast<size_t>(count);
+                size_t low = 0;
+                size_t high = guess;
+                size_t jump = 1;
+
+                if (xrange_before_end(xrange_value(start, step, guess), end, step)) {
+                    low = guess + 1;
+
+                    while (xrange_before_end(xrange_value(start, step, guess + jump), end, step)) {
+                        low = guess + jump + 1;
+                        jump *= 2;
+                    }
+
+                    high = guess + jump;
+                } else {
+                    while (jump <= guess && !xrange_before_end(xrange_value(start, step, guess - jump), end, step)) {
+                        high = guess - jump;
+                        jump *= 2;
+                    }
+
+                    low = jump <= guess ? guess - jump + 1 : 0;
+                }
+
+                while (low < high) {
+                    size_t mid = low + (high - low) / 2;
+
+                    if (xrange_before_end(xrange_value(start, step, mid), end, step)) {
+                        low = mid + 1;
+                    } else {
+                        high = mid;
+                    }
+                }
+
+                return low;
+            }
+        }
+
+        // Index of x in the integral sequence start + i * step, i < size, or
+        // size if it is not there.
+        template<
+            typename T,
+            typename U
+        > constexpr size_t xrange_index_of(T start, T step, size_t size, const U& x) {
+            using W = std::uintmax_t;
+            T value = static_cast<T>(x);
+
+            // x must be representable in T to be one of its values.
+            if (static_cast<U>(value) != x) {
+                return size;
+            }
+
+            if constexpr (std::is_signed_v<U> && !std::is_signed_v<T>) {
+                if (x < 0) {
+                    return size;
+                }
+            }
+
+            if constexpr (std::is_signed_v<T> && !std::is_signed_v<U>) {
+                if (value < 0) {
+                    return size;
+                }
+            }
+            W offset = 0;
+            W stride = 0;
+
+            if (step > 0) {
+                if (value < start) {
+                    return size;
+                }
+
+                offset = W(value) - W(start);
+                stride = W(step);
+            } else {
+                if (value > start) {
+                    return size;
+                }
+
+                offset = W(start) - W(value);
+                stride = W(0) - W(step);
+            }
+
+            if (offset % stride != 0 || offset / stride >= size) {
+                return size;
+            }
+
+            return static_cast<size_t>(offset / stride);
+        }
+
+        template<typename R>
+        using RequireIntegralXRange = typename
+            std::enable_if<
+                std::is_integral<typename R::value_type>::value
+            >::type;
+    };
+
     template<typename T>
     class XRangeIterator {
     public:
         using value_type        = typename T::value_type;
-        using reference         = value_type&;
+        using reference         = value_type;
         using size_type         = typename T::size_type;
-        using pointer           = value_type*;
+        using pointer           = void;
         using difference_type   = typename T::difference_type;
-        using iterator_category = std::input_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::random_access_iterator_tag;
     public:
-        XRangeIterator(value_type value, value_type end_value, value_type step)
-            : value_(value)
-            , end_value_(end_value)
-            , step_(step)
-        {
-            if (step_ == 0) {
-                throw std::runtime_error("Third argument of xrange cannot be zero.");
-            }
+        constexpr XRangeIterator() = default;
 
-            if ((step_ < 0 && value_ < end_value_) || (step_ > 0 && value_ > end_value_)) {
-                value_ = end_value_;
-            }
-        }
+        constexpr XRangeIterator(value_type start, value_type step, difference_type index, bool wrapping = false)
+            : start_(start)
+            , step_(step)
+            , index_(index)
+            , value_(base::xrange_value(start, step, index))
+            , wrapping_(wrapping)
+        {}
     public:
-        bool operator==(const XRangeIterator<T>& other) const {
-            return value_ == other.value_;
+        constexpr bool operator==(const XRangeIterator<T>& other) const {
+            return index_ == other.index_;
         }
 
-        bool operator!=(const XRangeIterator<T>& other) const {
+        constexpr bool operator!=(const XRangeIterator<T>& other) const {
             return !(*this == other);
         }
 
-        value_type& operator*() {
+        constexpr bool operator<(const XRangeIterator<T>& other) const {
+            return index_ < other.index_;
+        }
+
+        constexpr bool operator>(const XRangeIterator<T>& other) const {
+            return other < *this;
+        }
+
+        constexpr bool operator<=(const XRangeIterator<T>& other) const {
+            return !(other < *this);
+        }
+
+        constexpr bool operator>=(const XRangeIterator<T>& other) const {
+            return !(*this < other);
+        }
+
+        constexpr value_type operator*() const {
             return value_;
         }
 
-        XRangeIterator& operator->() {
-            return *this;
+        constexpr value_type operator[](difference_type n) const {
+            return base::xrange_value(start_, step_, index_ + n);
         }
-        
-        XRangeIterator& operator++() {
-            value_ += step_;
 
-            if (!IsBordersOk()) {
-                value_ = end_value_;
+        // Loops terminate on the index alone. Integral values are advanced by
+        // a plain signed addition, which the compiler treats as an induction
+        // variable, so a loop over xrange(n) vectorizes like a raw counted
+        // loop. Ranges whose past-the-end value would overflow fall back to
+        // recomputing the value from the index.
+        constexpr XRangeIterator& operator++() {
+            ++index_;
+
+            if constexpr (std::is_integral_v<value_type>) {
+                if (wrapping_) {
+                    value_ = base::xrange_value(start_, step_, index_);
+                } else {
+                    value_ += step_;
+                }
+            } else {
+                value_ = base::xrange_value(start_, step_, index_);
             }
 
             return *this;
         }
 
-        XRangeIterator operator++(int) {
+        constexpr XRangeIterator operator++(int) {
             XRangeIterator res = *this;
             ++(*this);
 
             return res;
         }
-    private:
-        value_type value_;
-        value_type end_value_;
-        value_type step_;
-    private:
-        inline bool IsBordersOk() const noexcept {
-            if (step_ > 0) {
-                return value_ < end_value_;
-            }
 
-            return value_ > end_value_;
+        constexpr XRangeIterator& operator--() {
+            --index_;
+            value_ = base::xrange_value(start_, step_, index_);
+
+            return *this;
+        }
+
+        constexpr XRangeIterator operator--(int) {
+            XRangeIterator res = *this;
+            --(*this);
+
+            return res;
         }
+
+        constexpr XRangeIterator& operator+=(difference_type n) {
+            index_ += n;
+            value_ = base::xrange_value(start_, step_, index_);
+
+            return *this;
+        }
+
+        constexpr XRangeIterator& operator-=(difference_type n) {
+            return *this += -n;
+        }
+
+        constexpr XRangeIterator operator+(difference_type n) const {
+            XRangeIterator res = *this;
+            res += n;
+
+            return res;
+        }
+
+        friend constexpr XRangeIterator operator+(difference_type n, const XRangeIterator& it) {
+            return it + n;
+        }
+
+        constexpr XRangeIterator operator-(difference_type n) const {
+            XRangeIterator res = *this;
+            res -= n;
+
+            return res;
+        }
+
+        constexpr difference_type operator-(const XRangeIterator<T>& other) const {
+            return index_ - other.index_;
+        }
+    private:
+        value_type start_{};
+        value_type step_{};
+        difference_type index_{};
+        value_type value_{};
+        bool wrapping_ = false;
     };
 
     template<typename T>
@@ -86,34 +368,263 @@ namespace lab {
         using difference_type = ptrdiff_t;
         using size_type       = size_t;
     public:
-        xrange(T end)
-            : start_(0)
-            , end_(end)
-            , step_(1)
+        constexpr xrange(T end)
+            : xrange(T(0), end, T(1))
         {}
-        
-        xrange(T start, T end)
-            : start_(start)
-            , end_(end)
-            , step_(1)
+
+        constexpr xrange(T start, T end)
+            : xrange(start, end, T(1))
         {}
 
-        xrange(T start, T end, T step)
+        constexpr xrange(T start, T end, T step)
             : start_(start)
             , end_(end)
             , step_(step)
-        {}
+        {
+            if (step_ == 0) {
+                throw std::runtime_error("Third argument of xrange cannot be zero.");
+            }
+
+            size_ = base::xrange_size(start_, end_, step_);
+            wrapping_ = base::xrange_end_overflows(start_, step_, size_);
+        }
     public:
-        iterator begin() {
-            return iterator(start_, end_, step_);
+        constexpr iterator begin() const {
+            return iterator(start_, step_, 0, wrapping_);
+        }
+
+        // The end iterator is a counted sentinel: it carries the precomputed
+        // trip count, and comparison against it is a single index test.
+        constexpr iterator end() const {
+            return iterator(start_, step_, static_cast<difference_type>(size_), wrapping_);
+        }
+
+        constexpr size_type size() const {
+            return size_;
+        }
+
+        constexpr bool empty() const {
+            return size_ == 0;
+        }
+
+        constexpr value_type operator[](size_type index) const {
+            return base::xrange_value(start_, step_, index);
+        }
+
+        // Writes the first min(size(), out.size()) values to out with a
+        // vectorized kernel and returns how many were written.
+        constexpr size_type fill(std::span<T> out) const {
+            size_type count = std::min(size_, out.size());
+
+            if (std::is_constant_evaluated()) {
+                for (size_type i = 0; i < count; ++i) {
+                    out[i] = (*this)[i];
+                }
+
+                return count;
+            }
+
+#if defined(LAB_XRANGE_USE_FMA)
+            simd::Iota<T, true>(out.data(), count, start_, step_, 0);
+#else
+            simd::Iota<T, false>(out.data(), count, start_, step_, 0);
+#endif
+
+            return count;
+        }
+
+        // Integral ranges answer from arithmetic on start and step;
+        // floating-point ones, whose computed values may round onto each
+        // other, use binary search.
+        template<typename U>
+        constexpr size_type index_of(const U& x) const {
+            if constexpr (std::is_integral_v<T> && std::is_integral_v<U>) {
+                return base::xrange_index_of(start_, step_, size_, x);
+            } else {
+                iterator first = begin();
+                iterator it;
+
+                if (step_ > 0) {
+                    it = std::lower_bound(first, end(), x);
+                } else {
+                    it = std::lower_bound(first, end(), x, [](const T& a, const U& b) {
+                        return a > b;
+                    });
+                }
+
+                return it != end() && *it == x ? static_cast<size_type>(it - first) : size_;
+            }
         }
 
-        iterator end() {
-            return iterator(end_, end_, step_);
+        template<typename U>
+        constexpr bool contains(const U& x) const {
+            return index_of(x) != size_;
         }
     private:
         T start_;
         T end_;
         T step_;
+        size_type size_ = 0;
+        bool wrapping_ = false;
     };
+
+    namespace base {
+        template<auto... Args>
+        struct StaticXRangeArgs;
+
+        template<auto End>
+        struct StaticXRangeArgs<End> {
+            using type = decltype(End);
+
+            static constexpr xrange<type> range{End};
+        };
+
+        template<
+            auto Start,
+            auto End
+        > struct StaticXRangeArgs<Start, End> {
+            using type = std::common_type_t<decltype(Start), decltype(End)>;
+
+            static constexpr xrange<type> range{Start, End};
+        };
+
+        template<
+            auto Start,
+            auto End,
+            auto Step
+        > struct StaticXRangeArgs<Start, End, Step> {
+            using type = std::common_type_t<decltype(Start), decltype(End), decltype(Step)>;
+
+            static constexpr xrange<type> range{Start, End, Step};
+        };
+    };
+
+    // xrange with bounds known at compile time, taking the same one, two or
+    // three arguments: static_xrange<8>, static_xrange<2, 8>,
+    // static_xrange<0, 16, 4>. A zero step fails to compile.
+    template<auto... Args>
+    class static_xrange {
+    public:
+        using value_type      = typename base::StaticXRangeArgs<Args...>::type;
+        using iterator        = typename xrange<value_type>::iterator;
+        using difference_type = ptrdiff_t;
+        using size_type       = size_t;
+    public:
+        static constexpr xrange<value_type> range = base::StaticXRangeArgs<Args...>::range;
+    public:
+        constexpr iterator begin() const {
+            return range.begin();
+        }
+
+        constexpr iterator end() const {
+            return range.end();
+        }
+
+        static constexpr size_type size() {
+            return range.size();
+        }
+
+        static constexpr bool empty() {
+            return range.empty();
+        }
+
+        template<size_type I>
+        static constexpr value_type get() {
+            static_assert(I < size(), "static_xrange index out of range");
+
+            return range[I];
+        }
+    };
+
+    namespace base {
+        template<
+            class Range,
+            class Function,
+            size_t... I
+        > constexpr void for_each_static_base(Function& f, std::index_sequence<I...>) {
+            (f(std::integral_constant<typename Range::value_type, Range::template get<I>()>()), ...);
+        }
+    };
+
+    // Calls f once per value as straight-line code, without a loop. Values are
+    // passed as std::integral_constant, so f can use them in constant
+    // expressions, e.g. as template arguments.
+    template<
+        auto... Args,
+        class Function
+    > constexpr void for_each_static(static_xrange<Args...>, Function f) {
+        base::for_each_static_base<static_xrange<Args...>>(f, std::make_index_sequence<static_xrange<Args...>::size()>());
+    }
+
+    template<typename T>
+    size_t collect_into(const xrange<T>& range, std::span<T> out) {
+        return range.fill(out);
+    }
+
+    // Appends all values of the range to out.
+    template<
+        typename T,
+        class Allocator
+    > void collect_into(const xrange<T>& range, std::vector<T, Allocator>& out) {
+        size_t offset = out.size();
+
+        out.resize(offset + range.size());
+        range.fill(std::span<T>(out.data() + offset, range.size()));
+    }
+
+    // Integral xranges are strictly monotonic arithmetic sequences, so the
+    // algorithms below reduce to a look at the first two values. These
+    // overloads are more specialized than the generic ones in
+    // stl-algorithms.h and win overload resolution.
+
+    template<
+        class R,
+        typename = base::RequireIntegralXRange<R>
+    > constexpr bool is_sorted(XRangeIterator<R> first, XRangeIterator<R> last) {
+        return last - first < 2 || *first < first[1];
+    }
+
+    template<
+        class R,
+        typename = base::RequireIntegralXRange<R>
+    > constexpr bool is_palindrome(XRangeIterator<R> first, XRangeIterator<R> last) {
+        return last - first < 2;
+    }
+
+    template<
+        class R,
+        typename T,
+        typename = base::RequireIntegralXRange<R>
+    > constexpr XRangeIterator<R> find_not(XRangeIterator<R> first, XRangeIterator<R> last, const T& x) {
+        if (first == last || !(*first == x)) {
+            return first;
+        }
+
+        return first + 1;
+    }
+
+    template<
+        class R,
+        typename T,
+        typename = base::RequireIntegralXRange<R>
+    > constexpr XRangeIterator<R> find_backward(XRangeIterator<R> first, XRangeIterator<R> last, const T& x) {
+        if constexpr (std::is_integral_v<T>) {
+            ptrdiff_t size = last - first;
+
+            if (size < 2) {
+                return size == 1 && *first == x ? first : last;
+            }
+
+            return first + static_cast<ptrdiff_t>(
+                base::xrange_index_of(
+                    *first,
+                    static_cast<typename R::value_type>(first[1] - *first),
+                    static_cast<size_t>(size),
+                    x
+                )
+            );
+        } else {
+            return lab::find_last(first, last, base::BaseFindPredicate<T>(x));
+        }
+    }
 };
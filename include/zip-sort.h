@@ -0,0 +1,280 @@
+#pragma once
+
+#include "zip.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cinttypes>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+namespace lab {
+    namespace base {
+        // Buckets smaller than this are finished by a comparison sort.
+        constexpr ptrdiff_t kRadixSortCutoff = 64;
+
+        // Ranges of at most this many rows are finished by insertion sort.
+        constexpr ptrdiff_t kZipInsertionCutoff = 16;
+
+        template<typename T>
+        constexpr bool kRadixSortable = (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+            || std::is_same_v<T, float>
+            || std::is_same_v<T, double>;
+
+        template<typename T>
+        struct RadixKeySelector {
+            using type = std::make_unsigned_t<T>;
+        };
+
+        template<>
+        struct RadixKeySelector<float> {
+            using type = uint32_t;
+        };
+
+        template<>
+        struct RadixKeySelector<double> {
+            using type = uint64_t;
+        };
+
+        template<typename T>
+        using RadixKey = typename RadixKeySelector<T>::type;
+
+        // Maps a key to an unsigned integer with the same order: the sign
+        // bit of integers is flipped, negative floats have all bits flipped
+        // and the others just the sign bit.
+        template<typename T>
+        RadixKey<T> radix_key(T value) {
+            using U = RadixKey<T>;
+
+            constexpr U kSign = U(1) << (std::numeric_limits<U>::digits - 1);
+
+            if constexpr (std::is_floating_point_v<T>) {
+                U bits = std::bit_cast<U>(value);
+
+                return (bits & kSign) ? U(~bits) : U(bits | kSign);
+            } else if constexpr (std::is_signed_v<T>) {
+                return static_cast<U>(value) ^ kSign;
+            } else {
+                return value;
+            }
+        }
+
+        // Restores the heap property below root in the max-heap [first,
+        // first + n).
+        template<
+            class RandomIt,
+            class Less
+        > void zip_sift_down(RandomIt first, ptrdiff_t n, ptrdiff_t root, const Less& less) {
+            for (ptrdiff_t child = 2 * root + 1; child < n; child = 2 * root + 1) {
+                if (child + 1 < n && less(first[child], first[child + 1])) {
+                    ++child;
+                }
+
+                if (!less(first[root], first[child])) {
+                    return;
+                }
+
+                iter_swap(first + root, first + child);
+                root = child;
+            }
+        }
+
+        // Introsort that only ever swaps rows and compares them in place, so
+        // a zipped row is never materialized: std::sort (and libstdc++'s
+        // std::ranges::sort, which calls it) copies rows into temporaries
+        // through the reference proxy. less(a, b) takes two row references.
+        template<
+            class RandomIt,
+            class Less
+        > void zip_introsort(RandomIt first, RandomIt last, const Less& less, int depth) {
+            while (last - first > kZipInsertionCutoff) {
+                ptrdiff_t n = last - first;
+
+                if (depth-- == 0) {
+                    for (ptrdiff_t i = n / 2; i-- > 0;) {
+                        zip_sift_down(first, n, i, less);
+                    }
+
+                    for (ptrdiff_t end = n - 1; end > 0; --end) {
+                        iter_swap(first, first + end);
+                        zip_sift_down(first, end, 0, less);
+                    }
+
+                    return;
+                }
+
+                // The median of three goes to the front as the pivot.
+                RandomIt a = first + 1;
+                RandomIt b = first + n / 2;
+                RandomIt c = last - 1;
+
+                if (less(*b, *a)) {
+                    iter_swap(a, b);
+                }
+
+                if (less(*c, *b)) {
+                    iter_swap(b, c);
+
+                    if (less(*b, *a)) {
+                        iter_swap(a, b);
+                    }
+                }
+
+                iter_swap(first, b);
+
+                // Both scans stop on rows equal to the pivot, so that runs of
+                // equal keys are split evenly.
+                RandomIt i = first + 1;
+                RandomIt j = last - 1;
+
+                while (true) {
+                    while (i <= j && less(*i, *first)) {
+                        ++i;
+                    }
+
+                    while (i <= j && less(*first, *j)) {
+                        --j;
+                    }
+
+                    if (i >= j) {
+                        break;
+                    }
+
+                    iter_swap(i, j);
+                    ++i;
+                    --j;
+                }
+
+                iter_swap(first, j);
+
+                // Recursing into the smaller side keeps the stack logarithmic.
+                if (j - first < last - j) {
+                    zip_introsort(first, j, less, depth);
+                    first = j + 1;
+                } else {
+                    zip_introsort(j + 1, last, less, depth);
+                    last = j;
+                }
+            }
+
+            for (RandomIt it = first; it != last; ++it) {
+                for (RandomIt jt = it; jt != first && less(*jt, *(jt - 1)); --jt) {
+                    iter_swap(jt, jt - 1);
+                }
+            }
+        }
+
+        template<
+            class RandomIt,
+            class Less
+        > void zip_sort(RandomIt first, RandomIt last, const Less& less) {
+            zip_introsort(first, last, less, 2 * std::bit_width(static_cast<size_t>(last - first)));
+        }
+
+        // American flag sort: one counting pass over the current byte of
+        // the keys, then whole rows are swapped into their buckets in place
+        // and every bucket is sorted by the next byte.
+        template<class RandomIt>
+        void american_flag_sort(RandomIt first, RandomIt last, int shift) {
+            using Key = std::remove_cvref_t<std::tuple_element_t<0, std::iter_value_t<RandomIt>>>;
+
+            auto key_of = [](const auto& row) {
+                return radix_key<Key>(std::get<0>(row));
+            };
+
+            if (last - first <= kRadixSortCutoff) {
+                zip_sort(first, last, [&key_of](const auto& a, const auto& b) {
+                    return key_of(a) < key_of(b);
+                });
+
+                return;
+            }
+
+            auto digit = [&key_of, shift](const auto& row) {
+                return static_cast<size_t>((key_of(row) >> shift) & 0xff);
+            };
+
+            std::array<ptrdiff_t, 256> counts{};
+
+            for (RandomIt it = first; it != last; ++it) {
+                ++counts[digit(*it)];
+            }
+
+            std::array<ptrdiff_t, 256> heads;
+            std::array<ptrdiff_t, 256> tails;
+            ptrdiff_t offset = 0;
+
+            for (size_t b = 0; b < 256; ++b) {
+                heads[b] = offset;
+                offset += counts[b];
+                tails[b] = offset;
+            }
+
+            for (size_t b = 0; b < 256; ++b) {
+                while (heads[b] < tails[b]) {
+                    size_t d = digit(first[heads[b]]);
+
+                    while (d != b) {
+                        iter_swap(first + heads[b], first + heads[d]++);
+                        d = digit(first[heads[b]]);
+                    }
+
+                    ++heads[b];
+                }
+            }
+
+            if (shift == 0) {
+                return;
+            }
+
+            offset = 0;
+
+            for (size_t b = 0; b < 256; ++b) {
+                if (counts[b] > 1) {
+                    american_flag_sort(first + offset, first + offset + counts[b], shift - 8);
+                }
+
+                offset += counts[b];
+            }
+        }
+    };
+
+    // Sorts zipped sequences by the elements of the first one, permuting all
+    // of them in place. Rows with equal keys end up in unspecified order.
+    //
+    //     lab::sort(lab::zip(keys, values));
+    //
+    // Integer and float keys in their natural order are radix sorted; other
+    // keys or comparators go through an introsort that only swaps rows, so
+    // no row is ever copied.
+    template<
+        class... Containers,
+        class Compare = std::less<>
+    > void sort(const zip<Containers...>& range, Compare comp = Compare()) {
+        using Iter = typename zip<Containers...>::iterator;
+        using Key = std::remove_cvref_t<std::tuple_element_t<0, std::iter_value_t<Iter>>>;
+
+        // The category rather than the concept: rows of move-only elements
+        // have no common reference with their value type, and the sort
+        // never needs one.
+        static_assert(
+            std::is_same_v<typename std::iterator_traits<Iter>::iterator_category, std::random_access_iterator_tag>,
+            "lab::sort needs random access containers"
+        );
+
+        constexpr bool kNaturalOrder = std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<Key>>;
+
+        if constexpr (kNaturalOrder && base::kRadixSortable<Key>) {
+            base::american_flag_sort(range.begin(), range.end(), std::numeric_limits<base::RadixKey<Key>>::digits - 8);
+        } else {
+            base::zip_sort(range.begin(), range.end(), [&comp](const auto& a, const auto& b) {
+                return comp(std::get<0>(a), std::get<0>(b));
+            });
+        }
+    }
+};
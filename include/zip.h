@@ -1,51 +1,225 @@
 #pragma once
 
+#include <algorithm>
 #include <cinttypes>
+#include <compare>
+#include <cstddef>
 #include <iterator>
+#include <ranges>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 namespace lab {
-    template<
-        class FirstContainer,
-        class SecondContainer
-    > class ZipIterator {
+    namespace base {
+        template<class Container>
+        using ContainerIterator = decltype(std::begin(std::declval<Container&>()));
+
+        // Two zipped sequences give a pair, so that .first and .second keep
+        // working; any other number gives a tuple.
+        template<typename... Ts>
+        struct ZipTupleSelector {
+            using type = std::tuple<Ts...>;
+        };
+
+        template<
+            typename T,
+            typename U
+        > struct ZipTupleSelector<T, U> {
+            using type = std::pair<T, U>;
+        };
+
+        template<typename... Ts>
+        using ZipTuple = typename ZipTupleSelector<Ts...>::type;
+
+        // The weakest category of the zipped iterators, capped at random
+        // access: a proxy reference cannot be contiguous.
+        template<class... Iters>
+        using ZipIteratorCategory = std::common_type_t<
+            std::random_access_iterator_tag,
+            typename std::iterator_traits<Iters>::iterator_category...
+        >;
+
+        template<class... Containers>
+        constexpr bool kZipSized = (std::ranges::sized_range<Containers&> && ...);
+    };
+
+    // What dereferencing a ZipIterator gives: a pair or tuple of references
+    // into the zipped containers. Copying it copies the references, not the
+    // elements; assigning to it and swapping it write through to the
+    // containers, moving from a temporary proxy and copying from a named
+    // one. Structured bindings bind straight to the elements.
+    template<typename... Refs>
+    class ZipReference : public base::ZipTuple<Refs...> {
+    public:
+        using base_type  = base::ZipTuple<Refs...>;
+        using value_type = base::ZipTuple<std::remove_cvref_t<Refs>...>;
+    public:
+        using base_type::base_type;
+
+        ZipReference(const ZipReference&) = default;
+        ZipReference(ZipReference&&) = default;
+
+        const ZipReference& operator=(const ZipReference& other) const {
+            Assign(other, std::index_sequence_for<Refs...>());
+
+            return *this;
+        }
+
+        // From a temporary proxy, as in *a = std::move(*b) inside the
+        // standard algorithms: the elements it refers to are moved from.
+        // A proxy is only ever a temporary in *a = *b as well, so to copy,
+        // assign a named proxy or a value.
+        const ZipReference& operator=(ZipReference&& other) const {
+            MoveFrom(other, std::index_sequence_for<Refs...>());
+
+            return *this;
+        }
+
+        // From a proxy of other references, e.g. the rvalue references that
+        // iter_move gives, which are moved from.
+        template<typename... Others>
+        const ZipReference& operator=(const ZipReference<Others...>& other) const {
+            static_assert(sizeof...(Others) == sizeof...(Refs), "zipped sequences count mismatch");
+
+            AssignFrom<Others...>(other, std::index_sequence_for<Refs...>());
+
+            return *this;
+        }
+
+        const ZipReference& operator=(const value_type& other) const {
+            Assign(other, std::index_sequence_for<Refs...>());
+
+            return *this;
+        }
+
+        const ZipReference& operator=(value_type&& other) const {
+            Assign(std::move(other), std::index_sequence_for<Refs...>());
+
+            return *this;
+        }
+
+        friend void swap(const ZipReference& a, const ZipReference& b) {
+            a.Swap(b, std::index_sequence_for<Refs...>());
+        }
+
+        // Lexicographic, like the value type, so that sorting and searching
+        // zipped sequences orders by the first one, then the next and so on.
+        friend bool operator==(const ZipReference& a, const ZipReference& b) {
+            return a.Tie() == b.Tie();
+        }
+
+        friend bool operator==(const ZipReference& a, const value_type& b) {
+            return a.Tie() == TieValue(b);
+        }
+
+        friend auto operator<=>(const ZipReference& a, const ZipReference& b) {
+            return a.Tie() <=> b.Tie();
+        }
+
+        friend auto operator<=>(const ZipReference& a, const value_type& b) {
+            return a.Tie() <=> TieValue(b);
+        }
+    private:
+        template<typename... Others>
+        friend class ZipReference;
+
+        template<
+            typename... Others,
+            typename Other,
+            size_t... I
+        > void AssignFrom(const Other& other, std::index_sequence<I...>) const {
+            ((std::get<I>(Base()) = static_cast<Others>(std::get<I>(other.Base()))), ...);
+        }
+
+        std::tuple<const std::remove_reference_t<Refs>&...> Tie() const {
+            return std::apply([](const auto&... elems) {
+                return std::tuple<const std::remove_reference_t<Refs>&...>(elems...);
+            }, Base());
+        }
+
+        static std::tuple<const std::remove_reference_t<Refs>&...> TieValue(const value_type& value) {
+            return std::apply([](const auto&... elems) {
+                return std::tuple<const std::remove_reference_t<Refs>&...>(elems...);
+            }, value);
+        }
+
+        template<
+            typename Other,
+            size_t... I
+        > void Assign(Other&& other, std::index_sequence<I...>) const {
+            ((std::get<I>(Base()) = std::get<I>(std::forward<Other>(other))), ...);
+        }
+
+        template<size_t... I>
+        void MoveFrom(const ZipReference& other, std::index_sequence<I...>) const {
+            ((std::get<I>(Base()) = std::move(std::get<I>(other.Base()))), ...);
+        }
+
+        template<size_t... I>
+        void Swap(const ZipReference& other, std::index_sequence<I...>) const {
+            using std::swap;
+
+            (swap(std::get<I>(Base()), std::get<I>(other.Base())), ...);
+        }
+
+        // Elements are references, so reaching them through a const base is
+        // still a path to the (mutable) container elements.
+        base_type& Base() const {
+            return const_cast<ZipReference&>(*this);
+        }
+    };
+
+    // Has the weakest category of the zipped iterators, up to random access.
+    // When every container knows its size, the end is a count of steps and
+    // comparing iterators is a single index comparison; otherwise iteration
+    // stops as soon as any of the sequences runs out.
+    template<class... Containers>
+    class ZipIterator {
     public:
-        using T                 = typename FirstContainer::value_type;
-        using U                 = typename SecondContainer::value_type;
-        using first_iter        = typename FirstContainer::iterator;
-        using second_iter       = typename SecondContainer::iterator;
-        using value_type        = std::pair<T, U>;
-        using reference         = value_type&;
+        using value_type        = base::ZipTuple<std::iter_value_t<base::ContainerIterator<Containers>>...>;
+        using reference         = ZipReference<std::iter_reference_t<base::ContainerIterator<Containers>>...>;
         using size_type         = size_t;
-        using pointer           = value_type*;
+        using pointer           = void;
         using difference_type   = ptrdiff_t;
-        using iterator_category = std::input_iterator_tag;
+        using iterator_category = base::ZipIteratorCategory<base::ContainerIterator<Containers>...>;
+        using iterator_concept  = iterator_category;
+    private:
+        static constexpr bool kCounted = base::kZipSized<Containers...>;
+        static constexpr bool kRandomAccess = std::is_same_v<iterator_category, std::random_access_iterator_tag>;
+        static constexpr bool kBidirectional = std::is_base_of_v<std::bidirectional_iterator_tag, iterator_category>;
     public:
-        ZipIterator(const first_iter& it1, const second_iter& it2)
-            : it1_(it1)
-            , it2_(it2)
+        ZipIterator() = default;
+
+        // An iterator that is index steps past the start of the sequences.
+        ZipIterator(difference_type index, const base::ContainerIterator<Containers>&... its)
+            : its_(its...)
+            , index_(index)
         {}
     public:
         bool operator==(const ZipIterator& other) const {
-            return it1_ == other.it1_ || it2_ == other.it2_;
+            if constexpr (kCounted) {
+                return index_ == other.index_;
+            } else {
+                return AnyEqual(other, std::index_sequence_for<Containers...>());
+            }
         }
-        
+
         bool operator!=(const ZipIterator& other) const {
             return !(*this == other);
         }
 
-        std::pair<T, U> operator*() {
-            return {*it1_, *it2_};
-        }
-
-        ZipIterator& operator->() {
-            return *this;
+        reference operator*() const {
+            return Dereference(std::index_sequence_for<Containers...>());
         }
 
         ZipIterator& operator++() {
-            ++it1_;
-            ++it2_;
-            
+            std::apply([](auto&... its) {
+                (++its, ...);
+            }, its_);
+
+            ++index_;
+
             return *this;
         }
 
@@ -55,39 +229,169 @@ namespace lab {
 
             return res;
         }
+
+        ZipIterator& operator--() requires kBidirectional {
+            std::apply([](auto&... its) {
+                (--its, ...);
+            }, its_);
+
+            --index_;
+
+            return *this;
+        }
+
+        ZipIterator operator--(int) requires kBidirectional {
+            ZipIterator res = *this;
+            --(*this);
+
+            return res;
+        }
+
+        ZipIterator& operator+=(difference_type n) requires kRandomAccess {
+            std::apply([n](auto&... its) {
+                ((its += n), ...);
+            }, its_);
+
+            index_ += n;
+
+            return *this;
+        }
+
+        ZipIterator& operator-=(difference_type n) requires kRandomAccess {
+            return *this += -n;
+        }
+
+        reference operator[](difference_type n) const requires kRandomAccess {
+            return *(*this + n);
+        }
+
+        friend ZipIterator operator+(ZipIterator it, difference_type n) requires kRandomAccess {
+            return it += n;
+        }
+
+        friend ZipIterator operator+(difference_type n, ZipIterator it) requires kRandomAccess {
+            return it += n;
+        }
+
+        friend ZipIterator operator-(ZipIterator it, difference_type n) requires kRandomAccess {
+            return it -= n;
+        }
+
+        friend difference_type operator-(const ZipIterator& a, const ZipIterator& b) requires kRandomAccess {
+            return a.index_ - b.index_;
+        }
+
+        friend auto operator<=>(const ZipIterator& a, const ZipIterator& b) requires kRandomAccess {
+            return a.index_ <=> b.index_;
+        }
+
+        // Moves the elements out, so that algorithms which move values
+        // around move every zipped element instead of copying it.
+        friend auto iter_move(const ZipIterator& it) {
+            return std::apply([](const auto&... its) {
+                return ZipReference<std::iter_rvalue_reference_t<base::ContainerIterator<Containers>>...>(std::ranges::iter_move(its)...);
+            }, it.its_);
+        }
+
+        friend void iter_swap(const ZipIterator& a, const ZipIterator& b) {
+            swap(*a, *b);
+        }
     private:
-        first_iter it1_;
-        second_iter it2_;
+        std::tuple<base::ContainerIterator<Containers>...> its_;
+        difference_type index_ = 0;
+    private:
+        template<size_t... I>
+        bool AnyEqual(const ZipIterator& other, std::index_sequence<I...>) const {
+            return ((std::get<I>(its_) == std::get<I>(other.its_)) || ...);
+        }
+
+        template<size_t... I>
+        reference Dereference(std::index_sequence<I...>) const {
+            return reference(*std::get<I>(its_)...);
+        }
     };
 
-    template<
-        class FirstContainer,
-        class SecondContainer
-    > class zip {
+    // Zips any number of containers: element i is a reference proxy to the
+    // i-th elements of all of them, see ZipReference.
+    //
+    //     for (auto [key, value, weight] : lab::zip(keys, values, weights))
+    //
+    // When all containers are sized, so is the zip: size() is the shortest
+    // length, and with random access containers the zip can be sorted or
+    // searched with the standard algorithms.
+    template<class... Containers>
+    class zip {
     public:
-        using T                 = typename FirstContainer::value_type;
-        using U                 = typename SecondContainer::value_type;
-        using iterator          = ZipIterator<FirstContainer, SecondContainer>;
-        using value_type        = std::pair<T, U>;
-        using reference         = value_type&;
+        using iterator          = ZipIterator<Containers...>;
+        using value_type        = typename iterator::value_type;
+        using reference         = typename iterator::reference;
         using size_type         = size_t;
-        using pointer           = value_type*;
+        using pointer           = void;
         using difference_type   = ptrdiff_t;
     public:
-        zip(FirstContainer& cont1, SecondContainer& cont2)
-            : cont1_(cont1)
-            , cont2_(cont2)
+        zip(Containers&... conts)
+            : conts_(conts...)
         {}
     public:
-        iterator begin() {
-            return iterator(cont1_.begin(), cont2_.begin());
+        iterator begin() const {
+            return std::apply([](auto&... conts) {
+                return iterator(0, std::begin(conts)...);
+            }, conts_);
+        }
+
+        iterator end() const {
+            if constexpr (base::kZipSized<Containers...>) {
+                difference_type n = static_cast<difference_type>(size());
+
+                // The end must also be where the shortest sequence ends in
+                // the longer ones, or stepping back from it would go out of
+                // step. That is free unless a longer container is not random
+                // access.
+                return std::apply([n](auto&... conts) {
+                    return iterator(n, EndOf(conts, n)...);
+                }, conts_);
+            } else {
+                return std::apply([](auto&... conts) {
+                    return iterator(0, std::end(conts)...);
+                }, conts_);
+            }
+        }
+
+        size_type size() const requires base::kZipSized<Containers...> {
+            return std::apply([](auto&... conts) {
+                return std::min({static_cast<size_type>(std::ranges::size(conts))...});
+            }, conts_);
         }
 
-        iterator end() {
-            return iterator(cont1_.end(), cont2_.end());
+        bool empty() const {
+            return begin() == end();
         }
     private:
-        FirstContainer& cont1_;
-        SecondContainer& cont2_;
+        std::tuple<Containers&...> conts_;
+    private:
+        template<class Container>
+        static base::ContainerIterator<Container> EndOf(Container& cont, difference_type n) {
+            if constexpr (std::is_base_of_v<std::bidirectional_iterator_tag, typename iterator::iterator_category>) {
+                if (static_cast<difference_type>(std::ranges::size(cont)) != n) {
+                    return std::next(std::begin(cont), n);
+                }
+            }
+
+            return std::end(cont);
+        }
     };
 };
+
+namespace std {
+    template<typename... Refs>
+    struct tuple_size<lab::ZipReference<Refs...>>
+        : std::integral_constant<size_t, sizeof...(Refs)>
+    {};
+
+    template<
+        size_t I,
+        typename... Refs
+    > struct tuple_element<I, lab::ZipReference<Refs...>>
+        : tuple_element<I, std::tuple<Refs...>>
+    {};
+};
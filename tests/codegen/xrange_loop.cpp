@@ -0,0 +1,26 @@
+// Compiled, not run: the XRangeLoopVectorizes tests check the optimizer
+// report to make sure a loop over lab::xrange stays a plain counted loop.
+
+#include "../../include/xrange.h"
+
+#if defined(XRANGE_LOOP_SUM)
+
+int SumXRange(int n) {
+    int sum = 0;
+
+    for (auto i : lab::xrange(n)) {
+        sum += i;
+    }
+
+    return sum;
+}
+
+#elif defined(XRANGE_LOOP_STORE)
+
+void StoreXRange(int* out, int n) {
+    for (auto i : lab::xrange(n)) {
+        out[i] = i * 3;
+    }
+}
+
+#endif
@@ -2,9 +2,46 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
 #include <vector>
 
+namespace {
+    // Allocations made by the current thread, counted by the replacement
+    // operator new below.
+    thread_local size_t allocations = 0;
+};
+
+void* operator new(size_t size) {
+    ++allocations;
+
+    if (void* res = std::malloc(size == 0 ? 1 : size)) {
+        return res;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
 TEST(AlgorithmTestSuite, AllOfTest) {
     std::vector<int> a = {1, 2, 3, 4, 5};
 
@@ -119,6 +156,341 @@ TEST(AlgorithmTestSuite, FindBackwardTest) {
     ASSERT_TRUE(lab::find_backward(a.begin(), a.end(), 1) == (a.begin() + 4));
 }
 
+namespace {
+    // Checks every kernel and the dispatched algorithms against the scalar
+    // definition, with the answer at each position of a buffer longer than
+    // the widest vector.
+    template<typename T>
+    void CheckFindKernels(T fill, T other) {
+        for (size_t size : {0, 1, 7, 63, 64, 65, 200}) {
+            for (size_t pos = 0; pos <= size; ++pos) {
+                std::vector<T> data(size, fill);
+
+                if (pos < size) {
+                    data[pos] = other;
+                }
+
+                size_t first_other = lab::simd::FindScalar(data.data(), size, fill, false);
+                size_t last_fill = lab::simd::FindLastScalar(data.data(), size, fill, true);
+                size_t first_fill = lab::simd::FindScalar(data.data(), size, fill, true);
+                size_t last_other = lab::simd::FindLastScalar(data.data(), size, fill, false);
+
+                ASSERT_EQ(lab::simd::Find(data.data(), size, fill, false), first_other);
+                ASSERT_EQ(lab::simd::FindLast(data.data(), size, fill, true), last_fill);
+                ASSERT_EQ(lab::simd::Find(data.data(), size, fill, true), first_fill);
+                ASSERT_EQ(lab::simd::FindLast(data.data(), size, fill, false), last_other);
+
+#if defined(LAB_SIMD_X86)
+                if (lab::simd::Supports(lab::simd::Isa::Sse2)) {
+                    ASSERT_EQ(lab::simd::FindSse2(data.data(), size, fill, false), first_other);
+                    ASSERT_EQ(lab::simd::FindLastSse2(data.data(), size, fill, true), last_fill);
+                    ASSERT_EQ(lab::simd::FindSse2(data.data(), size, fill, true), first_fill);
+                    ASSERT_EQ(lab::simd::FindLastSse2(data.data(), size, fill, false), last_other);
+                }
+
+                if (lab::simd::Supports(lab::simd::Isa::Avx2)) {
+                    ASSERT_EQ(lab::simd::FindAvx2(data.data(), size, fill, false), first_other);
+                    ASSERT_EQ(lab::simd::FindLastAvx2(data.data(), size, fill, true), last_fill);
+                    ASSERT_EQ(lab::simd::FindAvx2(data.data(), size, fill, true), first_fill);
+                    ASSERT_EQ(lab::simd::FindLastAvx2(data.data(), size, fill, false), last_other);
+                }
+
+                if (lab::simd::Supports(lab::simd::Isa::Avx512)) {
+                    ASSERT_EQ(lab::simd::FindAvx512(data.data(), size, fill, false), first_other);
+                    ASSERT_EQ(lab::simd::FindLastAvx512(data.data(), size, fill, true), last_fill);
+                    ASSERT_EQ(lab::simd::FindAvx512(data.data(), size, fill, true), first_fill);
+                    ASSERT_EQ(lab::simd::FindLastAvx512(data.data(), size, fill, false), last_other);
+                }
+#endif
+
+                auto not_it = lab::find_not(data.begin(), data.end(), fill);
+                auto back_it = lab::find_backward(data.begin(), data.end(), other);
+
+                ASSERT_EQ(static_cast<size_t>(not_it - data.begin()), first_other);
+                ASSERT_EQ(back_it - data.begin(), lab::find_last(data.begin(), data.end(), [other](T x) {
+                    return x == other;
+                }) - data.begin());
+            }
+        }
+    }
+
+    // The same for the sortedness and palindrome kernels: a strictly
+    // increasing run (crossing the sign bit where start allows) and a
+    // mirrored one, each broken at every position in turn.
+    template<typename T>
+    void CheckOrderKernels(T start) {
+        for (size_t size : {0, 1, 2, 7, 63, 64, 65, 129, 200}) {
+            for (size_t pos = 0; pos <= size; ++pos) {
+                std::vector<T> sorted(size);
+                std::vector<T> mirrored(size);
+
+                for (size_t i = 0; i < size; ++i) {
+                    sorted[i] = static_cast<T>(start + static_cast<T>(i));
+                    mirrored[i] = static_cast<T>(start + static_cast<T>(std::min(i, size - 1 - i)));
+                }
+
+                if (pos < size) {
+                    sorted[pos] = sorted[pos > 0 ? pos - 1 : 0];
+                    mirrored[pos] = static_cast<T>(mirrored[pos] + 1);
+                }
+
+                size_t sorted_until = lab::simd::SortedUntilScalar(sorted.data(), size);
+                size_t palindrome_until = lab::simd::PalindromeUntilScalar(mirrored.data(), size);
+
+                ASSERT_EQ(lab::simd::SortedUntil(sorted.data(), size), sorted_until);
+                ASSERT_EQ(lab::simd::PalindromeUntil(mirrored.data(), size), palindrome_until);
+
+#if defined(LAB_SIMD_X86)
+                if (lab::simd::Supports(lab::simd::Isa::Avx2)) {
+                    ASSERT_EQ(lab::simd::SortedUntilAvx2(sorted.data(), size), sorted_until);
+                    ASSERT_EQ(lab::simd::PalindromeUntilAvx2(mirrored.data(), size), palindrome_until);
+                }
+
+                if (lab::simd::Supports(lab::simd::Isa::Avx512)) {
+                    ASSERT_EQ(lab::simd::SortedUntilAvx512(sorted.data(), size), sorted_until);
+                    ASSERT_EQ(lab::simd::PalindromeUntilAvx512(mirrored.data(), size), palindrome_until);
+                }
+#endif
+
+                ASSERT_EQ(lab::is_sorted(sorted.begin(), sorted.end()), sorted_until == size);
+                ASSERT_EQ(static_cast<size_t>(lab::is_sorted_until(sorted.begin(), sorted.end()) - sorted.begin()), sorted_until);
+                ASSERT_EQ(lab::is_sorted(sorted.begin(), sorted.end(), std::less<T>()), sorted_until == size);
+                ASSERT_EQ(lab::is_palindrome(mirrored.begin(), mirrored.end()), palindrome_until == size);
+                ASSERT_EQ(static_cast<size_t>(lab::is_palindrome_until(mirrored.begin(), mirrored.end()) - mirrored.begin()), palindrome_until);
+                ASSERT_EQ(lab::is_palindrome(mirrored.begin(), mirrored.end(), std::equal_to<T>()), palindrome_until == size);
+            }
+        }
+    }
+};
+
+TEST(AlgorithmTestSuite, FindLastFromEndTest) {
+    std::list<int> log;
+
+    for (int i = 0; i < 1000; ++i) {
+        log.push_back(i % 10);
+    }
+
+    size_t calls = 0;
+
+    auto it = lab::find_last(log.begin(), log.end(), [&calls](int x) {
+        ++calls;
+
+        return x == 8;
+    });
+
+    ASSERT_EQ(std::distance(log.begin(), it), 998);
+    ASSERT_EQ(calls, 2);
+
+    calls = 0;
+
+    ASSERT_EQ(lab::find_last(log.begin(), log.end(), [&calls](int x) {
+        ++calls;
+
+        return x < 0;
+    }), log.end());
+    ASSERT_EQ(calls, 1000);
+
+    ASSERT_EQ(std::distance(log.begin(), lab::find_backward(log.begin(), log.end(), 0)), 990);
+    ASSERT_EQ(lab::find_backward(log.begin(), log.begin(), 0), log.begin());
+
+    std::istringstream stream("1 2 1 3");
+    std::istream_iterator<int> input(stream);
+
+    ASSERT_EQ(*lab::find_last(input, std::istream_iterator<int>(), [](int x) {
+        return x > 2;
+    }), 3);
+}
+
+TEST(AlgorithmTestSuite, SimdFindTest) {
+    CheckFindKernels<char>('a', 'b');
+    CheckFindKernels<uint8_t>(0, 255);
+    CheckFindKernels<int16_t>(-1, 1);
+    CheckFindKernels<int>(7, -7);
+    CheckFindKernels<uint32_t>(1, 1u << 31);
+    CheckFindKernels<int64_t>(1, int64_t(1) << 32);
+    CheckFindKernels<float>(1.5f, -0.25f);
+    CheckFindKernels<double>(0.0, std::numeric_limits<double>::quiet_NaN());
+}
+
+TEST(AlgorithmTestSuite, SimdOrderTest) {
+    CheckOrderKernels<int8_t>(-100);
+    CheckOrderKernels<uint8_t>(20);
+    CheckOrderKernels<int16_t>(-100);
+    CheckOrderKernels<uint16_t>(0x7fc0);
+    CheckOrderKernels<int>(-100);
+    CheckOrderKernels<uint32_t>(0x7fffffc0u);
+    CheckOrderKernels<int64_t>(-100);
+    CheckOrderKernels<uint64_t>(0x7fffffffffffffc0ull);
+    CheckOrderKernels<float>(-100.0f);
+    CheckOrderKernels<double>(-0.5);
+
+    // NaN is not less than anything, and -0.0 equals 0.0.
+    std::vector<double> with_nan(100, 0.0);
+    std::vector<float> zeros(100, 0.0f);
+
+    for (size_t i = 0; i < with_nan.size(); ++i) {
+        with_nan[i] = static_cast<double>(i);
+    }
+
+    with_nan[70] = std::numeric_limits<double>::quiet_NaN();
+    zeros[90] = -0.0f;
+
+    ASSERT_EQ(lab::is_sorted_until(with_nan.begin(), with_nan.end()), with_nan.begin() + 70);
+    ASSERT_TRUE(lab::is_palindrome(zeros.begin(), zeros.end()));
+}
+
+TEST(AlgorithmTestSuite, FindAnyOfKernelsTest) {
+    std::mt19937 gen(11);
+
+    for (size_t needles : {0, 1, 3, 40, 256}) {
+        lab::simd::ByteSet set;
+
+        for (size_t i = 0; i < needles; ++i) {
+            set.insert(static_cast<uint8_t>(needles == 256 ? i : gen()));
+        }
+
+        for (size_t size : {0, 1, 31, 32, 33, 64, 65, 300}) {
+            std::vector<uint8_t> data(size);
+
+            for (auto& x : data) {
+                x = static_cast<uint8_t>(gen());
+            }
+
+            for (bool member : {true, false}) {
+                size_t expected = lab::simd::FindAnyOfScalar(data.data(), size, set, member);
+
+                ASSERT_EQ(lab::simd::FindAnyOf(data.data(), size, set, member), expected);
+
+#if defined(LAB_SIMD_X86)
+                if (lab::simd::Supports(lab::simd::Isa::Avx2)) {
+                    ASSERT_EQ(lab::simd::FindAnyOfAvx2(data.data(), size, set, member), expected);
+                }
+
+                if (lab::simd::Supports(lab::simd::Isa::Avx512)) {
+                    ASSERT_EQ(lab::simd::FindAnyOfAvx512(data.data(), size, set, member), expected);
+                }
+#endif
+            }
+        }
+    }
+
+    lab::simd::ByteSet set;
+    set.insert(0x80);
+    set.insert(0x0f);
+
+    for (int b = 0; b < 256; ++b) {
+        ASSERT_EQ(set.contains(static_cast<uint8_t>(b)), b == 0x80 || b == 0x0f);
+    }
+}
+
+TEST(AlgorithmTestSuite, FindAnyOfTest) {
+    std::string text = "key = value; other\t=\xff more";
+    std::string delimiters = " =;\t";
+
+    for (size_t from = 0; from <= text.size(); ++from) {
+        auto first = text.begin() + from;
+        auto any = std::find_if(first, text.end(), [&delimiters](char c) {
+            return delimiters.find(c) != std::string::npos;
+        });
+        auto none = std::find_if(first, text.end(), [&delimiters](char c) {
+            return delimiters.find(c) == std::string::npos;
+        });
+
+        ASSERT_EQ(lab::find_any_of(first, text.end(), delimiters), any);
+        ASSERT_EQ(lab::find_not_any_of(first, text.end(), delimiters), none);
+    }
+
+    ASSERT_EQ(lab::find_any_of(text.begin(), text.end(), {'\xff'}) - text.begin(), 20);
+    ASSERT_EQ(lab::find_any_of(text.begin(), text.end(), {255, 300, -1}) - text.begin(), 20);
+    ASSERT_EQ(lab::find_any_of(text.begin(), text.end(), std::vector<int>{300}), text.end());
+    ASSERT_EQ(lab::find_not_any_of(text.begin(), text.end(), std::vector<char>()), text.begin());
+
+    std::list<char> chars(text.begin(), text.end());
+    ASSERT_EQ(std::distance(chars.begin(), lab::find_any_of(chars.begin(), chars.end(), {';', '\t'})), 11);
+
+    std::vector<int> ints;
+
+    for (int i = 0; i < 1000; ++i) {
+        ints.push_back(i * 7 % 1000);
+    }
+
+    std::vector<long> many;
+
+    for (long i = 0; i < 40; ++i) {
+        many.push_back(500 + i * 3);
+    }
+
+    many.push_back(1L << 40);
+
+    auto many_it = std::find_if(ints.begin(), ints.end(), [](int x) {
+        return x >= 500 && x < 620 && (x - 500) % 3 == 0;
+    });
+
+    ASSERT_EQ(lab::find_any_of(ints.begin(), ints.end(), many), many_it);
+    ASSERT_EQ(lab::find_any_of(ints.begin(), ints.end(), {7, 14}) - ints.begin(), 1);
+    ASSERT_EQ(lab::find_not_any_of(ints.begin(), ints.end(), {0, 7, 14}) - ints.begin(), 3);
+
+    std::vector<double> doubles = {std::nan(""), -0.0, 1.5};
+    ASSERT_EQ(lab::find_any_of(doubles.begin(), doubles.end(), {0.0, std::nan("")}) - doubles.begin(), 1);
+    ASSERT_EQ(lab::find_not_any_of(doubles.begin(), doubles.end(), {std::nan("")}), doubles.begin());
+
+    std::vector<std::string> words = {"a", "b", "c"};
+    ASSERT_EQ(lab::find_any_of(words.begin(), words.end(), {"c", "d"}) - words.begin(), 2);
+
+    // Past kLinearNeedles the needles are binary searched; NaN still
+    // matches nothing.
+    std::vector<double> nan_first = {std::nan(""), 5.0, 1.0};
+    std::vector<double> many_doubles = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0};
+
+    ASSERT_EQ(lab::find_any_of(nan_first.begin(), nan_first.end(), many_doubles) - nan_first.begin(), 1);
+    ASSERT_EQ(lab::find_not_any_of(nan_first.begin(), nan_first.end(), many_doubles), nan_first.begin());
+
+    many_doubles.push_back(std::nan(""));
+
+    ASSERT_EQ(lab::find_any_of(nan_first.begin(), nan_first.end(), many_doubles) - nan_first.begin(), 1);
+
+    // A string literal's terminating null is not a needle.
+    std::string with_null("ab\0cd", 5);
+
+    ASSERT_EQ(lab::find_any_of(with_null.begin(), with_null.end(), "dc") - with_null.begin(), 3);
+    ASSERT_EQ(lab::find_not_any_of(with_null.begin(), with_null.end(), "ab") - with_null.begin(), 2);
+    ASSERT_EQ(lab::find_any_of(with_null.begin(), with_null.end(), "x"), with_null.end());
+
+    std::list<char> null_list(with_null.begin(), with_null.end());
+
+    ASSERT_EQ(std::distance(null_list.begin(), lab::find_any_of(null_list.begin(), null_list.end(), "dc")), 3);
+
+    constexpr std::array<char, 3> kLetters = {'a', 'b', '\0'};
+    static_assert(lab::find_not_any_of(kLetters.begin(), kLetters.end(), "ab") == kLetters.begin() + 2);
+
+    constexpr std::array<int, 4> kValues = {1, 2, 3, 4};
+    static_assert(lab::find_not_any_of(kValues.begin(), kValues.end(), {1, 2}) == kValues.begin() + 2);
+}
+
+TEST(AlgorithmTestSuite, SimdFindMixedTypesTest) {
+    std::vector<int8_t> bytes = {1, -1, 2, -1, 3};
+    std::vector<uint32_t> words = {5, 0xffffffffu, 5};
+    std::vector<float> floats = {0.0f, -0.0f, std::nanf(""), 1.0f};
+
+    // Compared after the usual promotions, as the scalar loop would.
+    ASSERT_EQ(lab::find_backward(bytes.begin(), bytes.end(), -1) - bytes.begin(), 3);
+    ASSERT_EQ(lab::find_backward(bytes.begin(), bytes.end(), 255), bytes.end());
+    ASSERT_EQ(lab::find_not(bytes.begin(), bytes.end(), 257) - bytes.begin(), 0);
+    ASSERT_EQ(lab::find_backward(words.begin(), words.end(), 0xffffffffL) - words.begin(), 1);
+    ASSERT_EQ(lab::find_backward(words.begin(), words.end(), -1L), words.end());
+    ASSERT_EQ(lab::find_not(words.begin(), words.end(), 5L) - words.begin(), 1);
+
+    // Signed zeros are equal and NaN equals nothing.
+    ASSERT_EQ(lab::find_not(floats.begin(), floats.end(), 0.0f) - floats.begin(), 2);
+    ASSERT_EQ(lab::find_backward(floats.begin(), floats.end(), 0.0f) - floats.begin(), 1);
+    ASSERT_EQ(lab::find_backward(floats.begin(), floats.end(), std::nanf("")), floats.end());
+
+    std::string text = "needle in a haystack";
+
+    ASSERT_EQ(lab::find_backward(text.begin(), text.end(), 'a') - text.begin(), 17);
+    ASSERT_EQ(lab::find_not(text.begin(), text.end(), 'n') - text.begin(), 1);
+}
+
 TEST(AlgorithmTestSuite, IsPalindromeTest) {
     std::vector<int> a = {1, 2, 3, 4, 5};
     std::vector<int> b = {1, 2, 3, 2, 1};
@@ -133,3 +505,152 @@ TEST(AlgorithmTestSuite, IsPalindromeTest) {
     ASSERT_TRUE(lab::is_palindrome(b.begin(), b.end()));
     ASSERT_TRUE(lab::is_palindrome(b.begin(), b.end(), f));
 }
+
+TEST(AlgorithmTestSuite, EvenPalindromeTest) {
+    std::vector<int> a = {1, 2, 2, 1};
+    std::vector<int> b = {1, 2, 3, 1};
+    std::list<char> c = {'a', 'b', 'b', 'a'};
+
+    ASSERT_TRUE(lab::is_palindrome(a.begin(), a.end()));
+    ASSERT_FALSE(lab::is_palindrome(b.begin(), b.end()));
+    ASSERT_TRUE(lab::is_palindrome(c.begin(), c.end()));
+    ASSERT_TRUE(lab::is_palindrome(a.begin(), a.begin() + 2, [](int, int) {
+        return true;
+    }));
+}
+
+TEST(AlgorithmTestSuite, UntilTest) {
+    std::vector<int> sorted = {1, 2, 5, 7};
+    std::vector<int> unsorted = {1, 2, 5, 5, 7};
+    std::list<int> parts = {2, 4, 6, 1, 3, 8, 5};
+
+    auto even = [](int x) {
+        return x % 2 == 0;
+    };
+
+    ASSERT_EQ(lab::is_sorted_until(sorted.begin(), sorted.end()), sorted.end());
+    ASSERT_EQ(lab::is_sorted_until(unsorted.begin(), unsorted.end()) - unsorted.begin(), 3);
+    ASSERT_EQ(lab::is_sorted_until(unsorted.begin(), unsorted.end(), [](int x, int y) {
+        return x <= y;
+    }), unsorted.end());
+    ASSERT_EQ(lab::is_sorted_until(sorted.begin(), sorted.begin()), sorted.begin());
+
+    ASSERT_EQ(std::distance(parts.begin(), lab::is_partitioned_until(parts.begin(), parts.end(), even)), 5);
+    ASSERT_EQ(lab::is_partitioned_until(sorted.begin(), sorted.begin() + 1, even), sorted.begin() + 1);
+
+    std::vector<int> almost = {1, 2, 3, 4, 2, 1};
+
+    ASSERT_EQ(lab::is_palindrome_until(almost.begin(), almost.end()) - almost.begin(), 2);
+    ASSERT_EQ(lab::is_palindrome_until(almost.begin(), almost.begin() + 1), almost.begin() + 1);
+    ASSERT_EQ(lab::is_palindrome_until(sorted.begin(), sorted.end(), [](int x, int y) {
+        return x % 2 == y % 2;
+    }) - sorted.begin(), 1);
+}
+
+namespace {
+    struct MoveOnlyPredicate {
+        std::unique_ptr<int> bound;
+
+        bool operator()(int x) const {
+            return x < *bound;
+        }
+    };
+
+    struct MoveOnlyLess {
+        std::unique_ptr<int> calls = std::make_unique<int>(0);
+
+        bool operator()(int a, int b) const {
+            ++*calls;
+
+            return a < b;
+        }
+    };
+
+    struct MoveOnlyEqual {
+        std::unique_ptr<int> calls = std::make_unique<int>(0);
+
+        bool operator()(int a, int b) const {
+            ++*calls;
+
+            return a == b;
+        }
+    };
+};
+
+TEST(AlgorithmTestSuite, ScansDoNotAllocateTest) {
+    std::vector<std::string> words;
+
+    for (int i = 0; i < 100; ++i) {
+        words.push_back(std::string(40, static_cast<char>('a' + i % 26)) + std::to_string(1000 + i));
+    }
+
+    std::vector<std::string> mirrored = words;
+    mirrored.insert(mirrored.end(), words.rbegin(), words.rend());
+
+    std::vector<std::string> sorted = words;
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::string needle = words[50];
+    const std::string_view view = needle;
+    const std::vector<std::string_view> needles = {"x", view};
+
+    size_t before = allocations;
+
+    auto not_it = lab::find_not(words.begin(), words.end(), needle);
+    auto not_view_it = lab::find_not(words.begin(), words.end(), view);
+    auto back_it = lab::find_backward(words.begin(), words.end(), needle);
+    auto back_view_it = lab::find_backward(words.begin(), words.end(), view);
+    auto any_it = lab::find_any_of(words.begin(), words.end(), needles);
+    bool all = lab::all_of(words.begin(), words.end(), [view](const std::string& x) {
+        return x.size() == view.size();
+    });
+    bool one = lab::one_of(words.begin(), words.end(), [view](const std::string& x) {
+        return x == view;
+    });
+    bool is_sorted = lab::is_sorted(sorted.begin(), sorted.end());
+    bool is_sorted_less = lab::is_sorted(sorted.begin(), sorted.end(), std::less<>());
+    auto sorted_until = lab::is_sorted_until(words.begin(), words.end());
+    bool palindrome = lab::is_palindrome(mirrored.begin(), mirrored.end());
+    auto palindrome_until = lab::is_palindrome_until(words.begin(), words.end());
+
+    size_t after = allocations;
+
+    ASSERT_EQ(after, before);
+
+    ASSERT_EQ(not_it, words.begin());
+    ASSERT_EQ(not_view_it, words.begin());
+    ASSERT_EQ(back_it - words.begin(), 50);
+    ASSERT_EQ(back_view_it - words.begin(), 50);
+    ASSERT_EQ(any_it - words.begin(), 50);
+    ASSERT_TRUE(all);
+    ASSERT_TRUE(one);
+    ASSERT_TRUE(is_sorted);
+    ASSERT_TRUE(is_sorted_less);
+    ASSERT_EQ(sorted_until - words.begin(), 26);
+    ASSERT_TRUE(palindrome);
+    ASSERT_EQ(palindrome_until, words.begin());
+}
+
+TEST(AlgorithmTestSuite, MoveOnlyPredicateTest) {
+    std::vector<int> a = {1, 2, 3, 2, 1};
+
+    ASSERT_TRUE(lab::all_of(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(4)}));
+    ASSERT_TRUE(lab::any_of(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(2)}));
+    ASSERT_TRUE(lab::none_of(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(1)}));
+    ASSERT_FALSE(lab::one_of(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(2)}));
+    ASSERT_FALSE(lab::is_partitioned(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(2)}));
+    ASSERT_EQ(lab::find_if(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(2)}), a.begin());
+    ASSERT_EQ(lab::find_last(a.begin(), a.end(), MoveOnlyPredicate{std::make_unique<int>(2)}), a.begin() + 4);
+    ASSERT_FALSE(lab::is_sorted(a.begin(), a.end(), MoveOnlyLess()));
+    ASSERT_EQ(lab::is_sorted_until(a.begin(), a.end(), MoveOnlyLess()), a.begin() + 3);
+    ASSERT_TRUE(lab::is_palindrome(a.begin(), a.end(), MoveOnlyEqual()));
+    ASSERT_EQ(lab::is_palindrome_until(a.begin(), a.end(), MoveOnlyEqual()), a.end());
+
+    // The comparator is used in place, not copied: its calls are counted
+    // in the caller's object.
+    MoveOnlyLess less;
+    std::vector<int> b = {1, 2, 3, 4};
+
+    ASSERT_TRUE(lab::is_sorted(b.begin(), b.end(), std::ref(less)));
+    ASSERT_EQ(*less.calls, 3);
+}
@@ -0,0 +1,131 @@
+#include "../include/bit-span.h"
+#include "../include/stl-algorithms.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace {
+    // Checks the word-level algorithms against the bit-by-bit definitions
+    // on every subrange [from, to) of the bits that starts or ends near a
+    // word boundary.
+    template<class Iter>
+    void CheckBitAlgorithms(Iter begin, size_t size) {
+        auto is_set = [](bool bit) {
+            return bit;
+        };
+
+        auto is_clear = [](auto bit) {
+            return !bit;
+        };
+
+        auto always = [](bool) {
+            return true;
+        };
+
+        std::vector<size_t> edges;
+
+        for (size_t i = 0; i <= size; ++i) {
+            if (i % 64 <= 2 || i % 64 >= 62 || i == size) {
+                edges.push_back(i);
+            }
+        }
+
+        for (size_t from : edges) {
+            for (size_t to : edges) {
+                if (from > to) {
+                    continue;
+                }
+
+                Iter first = begin + from;
+                Iter last = begin + to;
+                size_t ones = std::count(first, last, true);
+                size_t count = to - from;
+
+                ASSERT_EQ(lab::all_of(first, last, is_set), ones == count);
+                ASSERT_EQ(lab::any_of(first, last, is_set), ones > 0);
+                ASSERT_EQ(lab::none_of(first, last, is_clear), ones == count);
+                ASSERT_EQ(lab::one_of(first, last, is_set), ones == 1);
+                ASSERT_EQ(lab::one_of(first, last, is_clear), count - ones == 1);
+                ASSERT_EQ(lab::one_of(first, last, always), count == 1);
+                ASSERT_EQ(lab::all_of(first, last, always), true);
+                ASSERT_EQ(lab::find_not(first, last, true), std::find(first, last, false));
+                ASSERT_EQ(lab::find_not(first, last, false), std::find(first, last, true));
+            }
+        }
+    }
+};
+
+TEST(BitSpanTestSuite, VectorBool) {
+    std::mt19937 gen(7);
+
+    for (size_t size : {0, 1, 63, 64, 65, 300}) {
+        for (int density : {0, 1, 50, 99, 100}) {
+            std::vector<bool> bits(size);
+
+            for (size_t i = 0; i < size; ++i) {
+                bits[i] = static_cast<int>(gen() % 100) < density;
+            }
+
+            CheckBitAlgorithms(bits.begin(), size);
+            CheckBitAlgorithms(bits.cbegin(), size);
+        }
+    }
+}
+
+TEST(BitSpanTestSuite, RawWords) {
+    std::vector<uint64_t> words = {0, ~uint64_t(0), 0x8000000000000001ull, 0x10};
+    lab::bit_span bits(words.data(), 250, 3);
+
+    ASSERT_EQ(bits.size(), 250);
+    ASSERT_FALSE(bits[0]);
+    ASSERT_TRUE(bits[61]);
+    ASSERT_TRUE(bits[125]);
+    ASSERT_TRUE(bits[188]);
+    ASSERT_TRUE(bits[193]);
+
+    CheckBitAlgorithms(bits.begin(), bits.size());
+
+    ASSERT_EQ(lab::find_not(bits.begin(), bits.end(), false) - bits.begin(), 61);
+    ASSERT_EQ(lab::find_not(bits.begin() + 61, bits.end(), true) - bits.begin(), 126);
+    ASSERT_TRUE(lab::one_of(bits.begin() + 189, bits.end(), [](bool bit) {
+        return bit;
+    }));
+}
+
+TEST(BitSpanTestSuite, Set) {
+    std::vector<uint32_t> words(3, 0);
+    lab::bit_span bits(words.data(), 90, 5);
+
+    bits.set(0, true);
+    bits.set(40, true);
+    bits.set(89, true);
+
+    ASSERT_EQ(words[0], 1u << 5);
+    ASSERT_EQ(words[1], 1u << 13);
+    ASSERT_EQ(words[2], 1u << 30);
+
+    bits.set(40, false);
+
+    ASSERT_EQ(words[1], 0u);
+    ASSERT_FALSE(lab::one_of(bits.begin(), bits.end(), [](bool bit) {
+        return bit;
+    }));
+}
+
+TEST(BitSpanTestSuite, GenericPredicateFallback) {
+    std::vector<bool> bits = {true, false, true};
+    size_t calls = 0;
+
+    // A predicate that takes the bit proxy itself still works bit by bit.
+    ASSERT_FALSE(lab::all_of(bits.begin(), bits.end(), [&calls](std::vector<bool>::reference bit) {
+        ++calls;
+
+        return static_cast<bool>(bit);
+    }));
+    ASSERT_EQ(calls, 2);
+}
@@ -0,0 +1,90 @@
+#include "../include/collect.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <list>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST(CollectTestSuite, XRange) {
+    auto values = lab::collect<std::vector<int>>(lab::xrange(1, 10, 2));
+
+    ASSERT_EQ(values, std::vector<int>({1, 3, 5, 7, 9}));
+    ASSERT_EQ(values.capacity(), values.size());
+
+    auto deduced = lab::collect<std::vector>(lab::xrange(0.5, 2.5));
+
+    ASSERT_EQ(deduced, std::vector<double>({0.5, 1.5}));
+
+    auto listed = lab::collect<std::list>(lab::xrange(3));
+
+    ASSERT_EQ(listed, std::list<int>({0, 1, 2}));
+}
+
+TEST(CollectTestSuite, Zip) {
+    std::vector<int> a = {3, 1, 2, 7};
+    std::vector<char> b = {'c', 'a', 'b'};
+
+    auto pairs = lab::collect<std::vector<std::pair<int, char>>>(lab::zip(a, b));
+
+    std::vector<std::pair<int, char>> expected = {{3, 'c'}, {1, 'a'}, {2, 'b'}};
+
+    ASSERT_EQ(pairs, expected);
+    ASSERT_EQ(pairs.capacity(), 3);
+
+    auto ordered = lab::collect<std::set>(lab::zip(a, b));
+
+    ASSERT_EQ(ordered.begin()->first, 1);
+    ASSERT_EQ(ordered.size(), 3);
+}
+
+TEST(CollectTestSuite, Unzip) {
+    std::vector<int> a = {1, 2, 3};
+    std::list<std::string> b = {"x", "y", "z", "w"};
+    std::vector<double> c = {0.5, 1.5, 2.5};
+
+    std::vector<int> a_out = {0};
+    std::vector<std::string> b_out;
+    std::set<double> c_out;
+
+    lab::unzip(lab::zip(a, b, c), a_out, b_out, c_out);
+
+    ASSERT_EQ(a_out, std::vector<int>({0, 1, 2, 3}));
+    ASSERT_EQ(a_out.capacity(), 4);
+    ASSERT_EQ(b_out, std::vector<std::string>({"x", "y", "z"}));
+    ASSERT_EQ(b_out.capacity(), 3);
+    ASSERT_EQ(c_out, std::set<double>({0.5, 1.5, 2.5}));
+}
+
+TEST(CollectTestSuite, MemoryResource) {
+    // The arena refuses to fall back to the heap, so these only pass if
+    // every allocation comes from the buffer and is sized exactly.
+    alignas(std::max_align_t) std::byte buffer[1024];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+
+    auto values = lab::collect<std::pmr::vector>(lab::xrange(100), &arena);
+
+    ASSERT_EQ(values.size(), 100);
+    ASSERT_EQ(values[99], 99);
+    ASSERT_EQ(values.get_allocator().resource(), &arena);
+
+    std::vector<int> a = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    std::vector<char> b(10, 'q');
+
+    auto pairs = lab::collect<std::pmr::vector<std::pair<int, char>>>(lab::zip(a, b), &arena);
+
+    ASSERT_EQ(pairs.size(), 10);
+    ASSERT_EQ(pairs.back(), std::make_pair(10, 'q'));
+
+    std::pmr::vector<int> a_out(&arena);
+    std::pmr::vector<char> b_out(&arena);
+
+    lab::unzip(lab::zip(a, b), a_out, b_out);
+
+    ASSERT_EQ(a_out.size(), 10);
+    ASSERT_EQ(b_out.size(), 10);
+}
@@ -0,0 +1,132 @@
+#include "../include/estimate.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+TEST(EstimateTestSuite, SortednessBounds) {
+    std::vector<int> a(1 << 20);
+    std::iota(a.begin(), a.end(), 0);
+
+    auto sorted = lab::estimate_sortedness(a.begin(), a.end(), 4000, 1);
+
+    ASSERT_EQ(sorted.descents.value, 0);
+    ASSERT_EQ(sorted.inversions.value, 0);
+    ASSERT_EQ(sorted.descents.samples, 4000);
+    ASSERT_LT(sorted.descents.upper, 0.002);
+
+    auto reversed = lab::estimate_sortedness(a.rbegin(), a.rend(), 4000, 1);
+
+    ASSERT_EQ(reversed.descents.value, 1);
+    ASSERT_EQ(reversed.inversions.value, 1);
+    ASSERT_GT(reversed.inversions.lower, 0.998);
+
+    std::shuffle(a.begin(), a.end(), std::mt19937(2));
+
+    auto shuffled = lab::estimate_sortedness(a.begin(), a.end(), 4000, 1);
+
+    ASSERT_LT(shuffled.inversions.lower, 0.5);
+    ASSERT_GT(shuffled.inversions.upper, 0.5);
+    ASSERT_LT(shuffled.inversions.upper - shuffled.inversions.lower, 0.04);
+
+    std::sort(a.begin(), a.end());
+
+    // One element in a hundred moved far away: about 2% of adjacent pairs
+    // break, almost no pairs at large are inverted.
+    for (size_t i = 0; i < a.size(); i += 100) {
+        a[i] = -a[i];
+    }
+
+    auto nearly = lab::estimate_sortedness(a.begin(), a.end(), 20000, 7);
+
+    ASSERT_LT(nearly.descents.lower, 0.01);
+    ASSERT_GT(nearly.descents.upper, 0.01);
+    ASSERT_LT(nearly.inversions.upper, 0.04);
+}
+
+TEST(EstimateTestSuite, DeterministicAndExactWhenSmall) {
+    std::vector<double> a(100000);
+    std::mt19937 gen(3);
+
+    for (double& x : a) {
+        x = std::uniform_real_distribution<double>(0, 1)(gen);
+    }
+
+    auto first = lab::estimate_sortedness(a.begin(), a.end(), 500, 99);
+    auto second = lab::estimate_sortedness(a.begin(), a.end(), 500, 99);
+
+    ASSERT_EQ(first.descents.value, second.descents.value);
+    ASSERT_EQ(first.inversions.value, second.inversions.value);
+    ASSERT_EQ(first.inversions.lower, second.inversions.lower);
+
+    // 3 adjacent pairs, 6 pairs: checked exactly. Strict, like is_sorted.
+    std::vector<int> small = {1, 2, 2, 0};
+    auto exact = lab::estimate_sortedness(small.begin(), small.end(), 100, 0);
+
+    ASSERT_DOUBLE_EQ(exact.descents.value, 2.0 / 3);
+    ASSERT_EQ(exact.descents.lower, exact.descents.upper);
+    ASSERT_DOUBLE_EQ(exact.inversions.value, 4.0 / 6);
+    ASSERT_EQ(exact.inversions.samples, 6);
+
+    std::vector<int> empty;
+    auto none = lab::estimate_sortedness(empty.begin(), empty.end(), 100, 0);
+
+    ASSERT_EQ(none.descents.samples, 0);
+    ASSERT_EQ(none.inversions.samples, 0);
+}
+
+TEST(EstimateTestSuite, Partitioned) {
+    std::vector<int> a(1 << 20);
+    std::iota(a.begin(), a.end(), 0);
+
+    auto small = [](int x) {
+        return x < (1 << 18);
+    };
+
+    auto partitioned = lab::estimate_partitioned(a.begin(), a.end(), small, 4000, 5);
+
+    ASSERT_EQ(partitioned.inversions.value, 0);
+    ASSERT_LT(partitioned.matching.lower, 0.25);
+    ASSERT_GT(partitioned.matching.upper, 0.25);
+
+    auto backwards = lab::estimate_partitioned(a.rbegin(), a.rend(), small, 4000, 6);
+
+    // A pair is inverted when its later element is small and its earlier
+    // one is not: 2 * 1/4 * 3/4 of all pairs.
+    ASSERT_LT(backwards.inversions.lower, 0.375);
+    ASSERT_GT(backwards.inversions.upper, 0.375);
+}
+
+TEST(EstimateTestSuite, PortableArithmetic) {
+    std::mt19937_64 gen(1);
+    std::vector<uint64_t> values = {0, 1, 2, 0xffffffff, 0x100000000, std::numeric_limits<uint64_t>::max()};
+
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(gen());
+        values.push_back(gen() >> (gen() % 64));
+    }
+
+    for (uint64_t a : values) {
+        for (uint64_t b : {uint64_t(3), uint64_t(1000000007), std::numeric_limits<uint64_t>::max(), values[values.size() / 2]}) {
+            ASSERT_EQ(lab::base::mul_high64_portable(a, b), lab::base::mul_high64(a, b)) << a << " " << b;
+            ASSERT_EQ(lab::base::mul_high64_portable(b, a), lab::base::mul_high64(a, b)) << a << " " << b;
+        }
+    }
+
+    for (size_t n = 0; n < 2000; ++n) {
+        for (size_t limit : {size_t(0), size_t(1), n, n * n / 2, n * (n - (n > 0)) / 2, n * n}) {
+            ASSERT_EQ(lab::base::pair_count_at_most(n, limit), n * (n - (n > 0)) / 2 <= limit) << n << " " << limit;
+        }
+    }
+
+    size_t max = std::numeric_limits<size_t>::max();
+
+    ASSERT_FALSE(lab::base::pair_count_at_most(max, max));
+    ASSERT_FALSE(lab::base::pair_count_at_most(size_t(1) << 33, max / 2));
+    ASSERT_TRUE(lab::base::pair_count_at_most(size_t(1) << 32, max));
+}
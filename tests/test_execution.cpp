@@ -0,0 +1,189 @@
+#include "../include/execution.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST(ExecutionTestSuite, QuantifiersTest) {
+    lab::ThreadPool pool(4);
+    auto par = lab::execution::par.on(pool);
+    std::vector<int> a(1 << 20, 1);
+
+    auto is_one = [](int x) {
+        return x == 1;
+    };
+
+    auto is_two = [](int x) {
+        return x == 2;
+    };
+
+    ASSERT_TRUE(lab::all_of(par, a.begin(), a.end(), is_one));
+    ASSERT_FALSE(lab::any_of(par, a.begin(), a.end(), is_two));
+    ASSERT_TRUE(lab::none_of(par, a.begin(), a.end(), is_two));
+    ASSERT_FALSE(lab::one_of(par, a.begin(), a.end(), is_two));
+
+    for (size_t pos : {size_t(0), size_t(12345), a.size() - 1}) {
+        a[pos] = 2;
+
+        ASSERT_FALSE(lab::all_of(par, a.begin(), a.end(), is_one));
+        ASSERT_TRUE(lab::any_of(lab::execution::par_unseq.on(pool), a.begin(), a.end(), is_two));
+        ASSERT_FALSE(lab::none_of(par, a.begin(), a.end(), is_two));
+        ASSERT_TRUE(lab::one_of(par, a.begin(), a.end(), is_two));
+
+        a[a.size() - 1 - pos / 2] = 2;
+        ASSERT_FALSE(lab::one_of(par, a.begin(), a.end(), is_two));
+
+        a.assign(a.size(), 1);
+    }
+}
+
+TEST(ExecutionTestSuite, SequentialFallbackTest) {
+    std::list<int> b = {1, 2, 3};
+    std::vector<int> small = {1, 2, 3};
+
+    auto positive = [](int x) {
+        return x > 0;
+    };
+
+    ASSERT_TRUE(lab::all_of(lab::execution::par, b.begin(), b.end(), positive));
+    ASSERT_TRUE(lab::all_of(lab::execution::seq, small.begin(), small.end(), positive));
+    ASSERT_FALSE(lab::one_of(lab::execution::par, small.begin(), small.end(), positive));
+}
+
+TEST(ExecutionTestSuite, ShortCircuitTest) {
+    lab::ThreadPool pool(4);
+    std::vector<int> a(1 << 24, 0);
+    std::atomic<size_t> calls{0};
+
+    a[100] = 1;
+
+    bool found = lab::any_of(lab::execution::par.on(pool), a.begin(), a.end(), [&calls](int x) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+
+        return x == 1;
+    });
+
+    ASSERT_TRUE(found);
+    // Every worker stops within a block or so of the hit.
+    ASSERT_LT(calls.load(), a.size() / 4);
+
+    a[200] = 1;
+    calls = 0;
+
+    ASSERT_FALSE(lab::one_of(lab::execution::par.on(pool), a.begin(), a.end(), [&calls](int x) {
+        calls.fetch_add(1, std::memory_order_relaxed);
+
+        return x == 1;
+    }));
+    ASSERT_LT(calls.load(), a.size() / 4);
+}
+
+TEST(ExecutionTestSuite, ExceptionTest) {
+    lab::ThreadPool pool(4);
+    std::vector<int> a(1 << 20, 0);
+
+    ASSERT_THROW(lab::all_of(lab::execution::par.on(pool), a.begin(), a.end(), [](int) -> bool {
+        throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+TEST(ExecutionTestSuite, PropertiesTest) {
+    lab::ThreadPool pool(4);
+    auto par = lab::execution::par.on(pool);
+
+    std::vector<int> a(1 << 20);
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int>(i);
+    }
+
+    ASSERT_TRUE(lab::is_sorted(par, a.begin(), a.end()));
+    ASSERT_EQ(lab::is_sorted_until(par, a.begin(), a.end()), a.end());
+
+    auto small = [](int x) {
+        return x < 1000;
+    };
+
+    ASSERT_TRUE(lab::is_partitioned(par, a.begin(), a.end(), small));
+    ASSERT_EQ(lab::is_partitioned_until(par, a.begin(), a.end(), small), a.end());
+
+    std::mt19937 gen(3);
+
+    for (int round = 0; round < 20; ++round) {
+        std::vector<int> b = a;
+        size_t pos = gen() % (b.size() - 1) + 1;
+
+        // Violations at a chunk boundary are caught like any other.
+        if (round % 2 == 0) {
+            pos = pos / lab::base::kCancelCheckBlock * lab::base::kCancelCheckBlock + 1;
+        }
+
+        b[pos] = b[pos - 1];
+
+        ASSERT_FALSE(lab::is_sorted(par, b.begin(), b.end()));
+        ASSERT_EQ(lab::is_sorted_until(par, b.begin(), b.end()), lab::is_sorted_until(b.begin(), b.end()));
+        ASSERT_EQ(lab::is_sorted_until(par, b.begin(), b.end(), [](int x, int y) {
+            return x <= y;
+        }), b.end());
+
+        b[pos] = 1;
+
+        ASSERT_EQ(lab::is_partitioned(par, b.begin(), b.end(), small), pos < 1000);
+        ASSERT_EQ(lab::is_partitioned_until(par, b.begin(), b.end(), small), lab::is_partitioned_until(b.begin(), b.end(), small));
+    }
+
+    std::vector<int> c(1 << 20);
+
+    for (size_t i = 0; i < c.size(); ++i) {
+        c[i] = static_cast<int>(std::min(i, c.size() - 1 - i));
+    }
+
+    ASSERT_TRUE(lab::is_palindrome(par, c.begin(), c.end()));
+    ASSERT_EQ(lab::is_palindrome_until(par, c.begin(), c.end()), c.end());
+
+    c[c.size() - 1 - 70000] = -1;
+
+    ASSERT_FALSE(lab::is_palindrome(par, c.begin(), c.end()));
+    ASSERT_EQ(lab::is_palindrome_until(par, c.begin(), c.end()) - c.begin(), 70000);
+    ASSERT_TRUE(lab::is_palindrome(par, c.begin(), c.end(), [](int x, int y) {
+        return (x < 0) == (y < 0) || x == 70000 || y == 70000;
+    }));
+}
+
+TEST(ExecutionTestSuite, PartitionSinglePassTest) {
+    lab::ThreadPool pool(4);
+    auto par = lab::execution::par.on(pool);
+    std::mt19937 gen(11);
+
+    for (int round = 0; round < 30; ++round) {
+        std::vector<int> a(1 << 18, 0);
+        size_t point = gen() % a.size();
+
+        std::fill(a.begin(), a.begin() + point, 1);
+
+        // Half the rounds break the partition: after the point, in the
+        // same block, or far from it.
+        if (round % 2 == 1) {
+            size_t at = round % 4 == 1 ? std::min(a.size() - 1, point + gen() % 100) : gen() % a.size();
+
+            a[at] = 1;
+        }
+
+        std::atomic<size_t> calls{0};
+        auto matches = [&calls](int x) {
+            calls.fetch_add(1, std::memory_order_relaxed);
+
+            return x == 1;
+        };
+
+        ASSERT_EQ(lab::is_partitioned_until(par, a.begin(), a.end(), matches), lab::is_partitioned_until(a.begin(), a.end(), [](int x) {
+            return x == 1;
+        }));
+        ASSERT_LE(calls.load(), a.size());
+    }
+}
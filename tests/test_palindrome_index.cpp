@@ -0,0 +1,75 @@
+#include "../include/palindrome-index.h"
+
+#include <gtest/gtest.h>
+
+#include <cctype>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Checks every [i, j) against lab::is_palindrome.
+    template<
+        class Iter,
+        class Predicate
+    > void CheckAllSubranges(Iter first, Iter last, const lab::palindrome_index& index, Predicate p) {
+        size_t n = std::distance(first, last);
+
+        ASSERT_EQ(index.size(), n);
+
+        for (size_t i = 0; i <= n; ++i) {
+            for (size_t j = i; j <= n; ++j) {
+                ASSERT_EQ(index.is_palindrome(i, j), lab::is_palindrome(std::next(first, i), std::next(first, j), p)) << i << " " << j;
+            }
+        }
+    }
+};
+
+TEST(PalindromeIndexTestSuite, AgreesWithIsPalindrome) {
+    std::mt19937 gen(3);
+    auto equal = [](char a, char b) {
+        return a == b;
+    };
+
+    for (size_t n : {0, 1, 2, 3, 10, 100}) {
+        for (int alphabet : {1, 2, 3, 26}) {
+            std::string s;
+
+            for (size_t i = 0; i < n; ++i) {
+                s.push_back(static_cast<char>('a' + gen() % alphabet));
+            }
+
+            CheckAllSubranges(s.begin(), s.end(), lab::palindrome_index(s.begin(), s.end()), equal);
+
+            std::list<char> list(s.begin(), s.end());
+
+            CheckAllSubranges(list.begin(), list.end(), lab::palindrome_index(list.begin(), list.end()), equal);
+        }
+    }
+}
+
+TEST(PalindromeIndexTestSuite, CustomEquivalence) {
+    std::string s = "Abc,cBa;Xy yX";
+
+    auto same_letter = [](char a, char b) {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    };
+
+    lab::palindrome_index index(s.begin(), s.end(), same_letter);
+
+    CheckAllSubranges(s.begin(), s.end(), index, same_letter);
+
+    ASSERT_TRUE(index.is_palindrome(0, 7));
+    ASSERT_TRUE(index.is_palindrome(8, 13));
+    ASSERT_FALSE(lab::palindrome_index(s.begin(), s.end()).is_palindrome(0, 7));
+}
+
+TEST(PalindromeIndexTestSuite, LongestAroundCenters) {
+    std::vector<int> a = {1, 2, 3, 2, 1, 1, 2, 3, 2, 1};
+    lab::palindrome_index index(a.begin(), a.end());
+
+    ASSERT_EQ(index.longest_odd(2), std::make_pair(size_t(0), size_t(5)));
+    ASSERT_EQ(index.longest_even(5), std::make_pair(size_t(0), size_t(10)));
+    ASSERT_EQ(index.longest_even(0), std::make_pair(size_t(0), size_t(0)));
+}
@@ -0,0 +1,99 @@
+#include "../include/parallel.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ParallelTestSuite, SumTest) {
+    std::atomic<long long> sum{0};
+
+    lab::parallel_for(lab::xrange(1000000), [&sum](int x) {
+        sum.fetch_add(x, std::memory_order_relaxed);
+    });
+
+    ASSERT_EQ(sum.load(), 1000000LL * 999999 / 2);
+}
+
+TEST(ParallelTestSuite, StepTest) {
+    auto range = lab::xrange(1000, 5, -7);
+    std::vector<std::atomic<int>> hits(1001);
+
+    lab::parallel_for(range, [&hits](int x) {
+        hits[x].fetch_add(1, std::memory_order_relaxed);
+    }, 3);
+
+    for (int x = 0; x <= 1000; ++x) {
+        bool expected = x > 5 && (1000 - x) % 7 == 0;
+
+        ASSERT_EQ(hits[x].load(), expected ? 1 : 0);
+    }
+}
+
+TEST(ParallelTestSuite, OwnPoolTest) {
+    lab::ThreadPool pool(4);
+    std::vector<int> out(100000);
+
+    lab::parallel_for(pool, lab::xrange(out.size()), [&out](size_t i) {
+        out[i] = static_cast<int>(i) * 2;
+    }, 1000);
+
+    for (size_t i = 0; i < out.size(); ++i) {
+        ASSERT_EQ(out[i], static_cast<int>(i) * 2);
+    }
+}
+
+TEST(ParallelTestSuite, EmptyTest) {
+    bool called = false;
+
+    lab::parallel_for(lab::xrange(5, 5), [&called](int) {
+        called = true;
+    });
+
+    ASSERT_FALSE(called);
+}
+
+TEST(ParallelTestSuite, ExceptionTest) {
+    lab::ThreadPool pool(4);
+
+    ASSERT_THROW(
+        lab::parallel_for(pool, lab::xrange(100000), [](int x) {
+            if (x == 54321) {
+                throw std::runtime_error("bad index");
+            }
+        }, 100),
+        std::runtime_error
+    );
+}
+
+TEST(ParallelTestSuite, NestedTest) {
+    lab::ThreadPool pool(2);
+    std::atomic<int> count{0};
+
+    lab::parallel_for(pool, lab::xrange(16), [&pool, &count](int) {
+        lab::parallel_for(pool, lab::xrange(100), [&count](int) {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }, 10);
+    }, 1);
+
+    ASSERT_EQ(count.load(), 1600);
+}
+
+TEST(ParallelTestSuite, SmallRangeGrainTest) {
+    auto chunks = [](size_t size, size_t threads) {
+        size_t grain = lab::base::parallel_grain(size, threads, 0);
+
+        return (size + grain - 1) / grain;
+    };
+
+    ASSERT_GE(chunks(100, 4), 4);
+    ASSERT_GE(chunks(16, 4), 4);
+    ASSERT_EQ(chunks(3, 4), 3);
+    ASSERT_EQ(lab::base::parallel_grain(1, 4, 0), 1);
+    ASSERT_EQ(lab::base::parallel_grain(100, 4, 7), 7);
+
+    // Large ranges still get aligned chunks.
+    ASSERT_EQ(lab::base::parallel_grain(1 << 20, 4, 0) % lab::base::kParallelChunkAlign, 0);
+    ASSERT_GE(chunks(1 << 20, 4), 4 * lab::base::kParallelChunksPerThread);
+}
@@ -0,0 +1,279 @@
+#include "../include/soa-vector.h"
+
+#include <gtest/gtest.h>
+
+#include <cinttypes>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    // Throws from the default constructor once a countdown runs out, and
+    // keeps count of live objects.
+    struct Fragile {
+        static inline int countdown = -1;
+        static inline int alive = 0;
+
+        Fragile() {
+            if (countdown >= 0 && countdown-- == 0) {
+                throw std::runtime_error("fragile");
+            }
+
+            ++alive;
+        }
+
+        Fragile(const Fragile&) {
+            ++alive;
+        }
+
+        ~Fragile() {
+            --alive;
+        }
+    };
+};
+
+namespace {
+    // Copies throw once a countdown runs out; the move may throw too, so
+    // containers copy it when they relocate.
+    struct ThrowingCopy {
+        static inline int countdown = -1;
+
+        int value = 0;
+
+        ThrowingCopy(int x)
+            : value(x)
+        {}
+
+        ThrowingCopy(const ThrowingCopy& other)
+            : value(other.value)
+        {
+            if (countdown >= 0 && countdown-- == 0) {
+                throw std::runtime_error("copy");
+            }
+        }
+
+        ThrowingCopy(ThrowingCopy&& other)
+            : value(other.value)
+        {}
+    };
+};
+
+TEST(SoaVectorTestSuite, PushBackAndGrowth) {
+    lab::soa_vector<int, std::string, double> v;
+
+    ASSERT_TRUE(v.empty());
+
+    for (int i = 0; i < 1000; ++i) {
+        v.push_back(i, std::to_string(i), i * 0.5);
+    }
+
+    ASSERT_EQ(v.size(), 1000);
+    ASSERT_GE(v.capacity(), 1000);
+
+    for (int i = 0; i < 1000; ++i) {
+        auto [a, b, c] = v[i];
+
+        ASSERT_EQ(a, i);
+        ASSERT_EQ(b, std::to_string(i));
+        ASSERT_EQ(c, i * 0.5);
+    }
+
+    v.pop_back();
+    ASSERT_EQ(v.size(), 999);
+    ASSERT_EQ(v.column<1>().back(), "998");
+
+    v.resize(1002);
+    ASSERT_EQ(v.column<0>()[1001], 0);
+    ASSERT_TRUE(v.column<1>()[1000].empty());
+
+    v.clear();
+    ASSERT_TRUE(v.empty());
+}
+
+TEST(SoaVectorTestSuite, PushBackOwnRow) {
+    lab::soa_vector<std::string, int> v;
+    v.push_back(std::string(100, 'a'), 7);
+
+    while (v.size() < v.capacity()) {
+        v.push_back("b", 0);
+    }
+
+    size_t capacity = v.capacity();
+    auto [s, x] = v[0];
+
+    v.push_back(s, x);
+
+    ASSERT_GT(v.capacity(), capacity);
+    ASSERT_EQ(v.column<0>().back(), std::string(100, 'a'));
+    ASSERT_EQ(v.column<1>().back(), 7);
+    ASSERT_EQ(v.column<0>()[0], std::string(100, 'a'));
+}
+
+TEST(SoaVectorTestSuite, ResizeRollback) {
+    {
+        lab::soa_vector<std::string, Fragile, Fragile> v(3);
+
+        ASSERT_EQ(Fragile::alive, 6);
+
+        Fragile::countdown = 10;
+        ASSERT_THROW(v.resize(10), std::runtime_error);
+        Fragile::countdown = -1;
+
+        ASSERT_EQ(v.size(), 3);
+        ASSERT_EQ(Fragile::alive, 6);
+
+        v.resize(5);
+        ASSERT_EQ(Fragile::alive, 10);
+    }
+
+    ASSERT_EQ(Fragile::alive, 0);
+}
+
+TEST(SoaVectorTestSuite, RelocationKeepsRowsOnThrow) {
+    lab::soa_vector<std::string, ThrowingCopy> v;
+
+    for (int i = 0; i < 64; ++i) {
+        v.push_back(std::string(50, static_cast<char>('a' + i % 26)), i);
+    }
+
+    ASSERT_EQ(v.capacity(), 64);
+
+    auto check = [&v]() {
+        ASSERT_EQ(v.size(), 64);
+
+        for (int i = 0; i < 64; ++i) {
+            ASSERT_EQ(v.column<0>()[i], std::string(50, static_cast<char>('a' + i % 26)));
+            ASSERT_EQ(v.column<1>()[i].value, i);
+        }
+    };
+
+    ThrowingCopy::countdown = 30;
+    ASSERT_THROW(v.reserve(128), std::runtime_error);
+    check();
+
+    ThrowingCopy::countdown = 30;
+    ASSERT_THROW(v.push_back("x", 64), std::runtime_error);
+    check();
+
+    ThrowingCopy::countdown = -1;
+    v.push_back("x", 64);
+
+    ASSERT_EQ(v.column<0>()[0], std::string(50, 'a'));
+    ASSERT_EQ(v.column<1>()[64].value, 64);
+}
+
+TEST(SoaVectorTestSuite, SingleAlignedAllocation) {
+    lab::soa_vector<char, double, int16_t> v;
+    v.reserve(100);
+
+    size_t capacity = v.capacity();
+
+    ASSERT_GE(capacity, 100);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(v.data<0>()) % lab::base::kSoaAlign, 0);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(v.data<1>()) % lab::base::kSoaAlign, 0);
+    ASSERT_EQ(reinterpret_cast<uintptr_t>(v.data<2>()) % lab::base::kSoaAlign, 0);
+
+    // Columns follow each other in one block.
+    ASSERT_EQ(reinterpret_cast<const char*>(v.data<1>()), v.data<0>() + capacity);
+    ASSERT_EQ(reinterpret_cast<const char*>(v.data<2>()), reinterpret_cast<const char*>(v.data<1>() + capacity));
+
+    const char* first = v.data<0>();
+
+    for (int i = 0; i < 100; ++i) {
+        v.push_back('a', 1.0, int16_t(i));
+    }
+
+    ASSERT_EQ(v.data<0>(), first);
+}
+
+TEST(SoaVectorTestSuite, ZipIteration) {
+    lab::soa_vector<int, float> v;
+
+    for (int i = 0; i < 10; ++i) {
+        v.push_back(10 - i, static_cast<float>(i));
+    }
+
+    for (auto [key, value] : v) {
+        value += static_cast<float>(key);
+    }
+
+    for (float value : v.column<1>()) {
+        ASSERT_EQ(value, 10.0f);
+    }
+
+    std::sort(v.begin(), v.end());
+
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQ(v.column<0>()[i], i + 1);
+    }
+
+    const auto& cv = v;
+    int sum = 0;
+
+    for (auto [key, value] : cv) {
+        sum += key;
+    }
+
+    ASSERT_EQ(sum, 55);
+    ASSERT_EQ(cv.end() - cv.begin(), 10);
+}
+
+TEST(SoaVectorTestSuite, CopyAndMove) {
+    lab::soa_vector<std::string, int> a;
+    a.push_back("x", 1);
+    a.push_back("y", 2);
+
+    lab::soa_vector<std::string, int> b = a;
+    b.column<0>()[0] = "z";
+
+    ASSERT_EQ(a.column<0>()[0], "x");
+    ASSERT_EQ(b.column<0>()[0], "z");
+    ASSERT_EQ(b.column<1>()[1], 2);
+
+    lab::soa_vector<std::string, int> c = std::move(b);
+
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(c.size(), 2);
+
+    a = c;
+    ASSERT_EQ(a.column<0>()[0], "z");
+}
+
+TEST(SoaVectorTestSuite, Blocks) {
+    lab::soa_vector<float, float, float> v(10000);
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        v.column<0>()[i] = static_cast<float>(i);
+        v.column<1>()[i] = 2.0f;
+    }
+
+    size_t rows = 0;
+
+    v.for_each_block([&rows](size_t offset, std::span<float> x, std::span<float> y, std::span<float> z) {
+        ASSERT_EQ(offset, rows);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(x.data()) % lab::base::kSoaAlign, 0);
+
+        for (size_t i = 0; i < x.size(); ++i) {
+            z[i] = x[i] * y[i];
+        }
+
+        rows += x.size();
+    });
+
+    ASSERT_EQ(rows, v.size());
+
+    for (size_t i = 0; i < v.size(); ++i) {
+        ASSERT_EQ(v.column<2>()[i], 2.0f * i);
+    }
+
+    size_t blocks = 0;
+
+    v.for_each_block([&blocks](size_t, std::span<float> x, std::span<float>, std::span<float>) {
+        ASSERT_LE(x.size(), 1000);
+        ++blocks;
+    }, 1000);
+
+    ASSERT_EQ(blocks, 10);
+}
@@ -0,0 +1,125 @@
+#define LAB_DEBUG_SORTED_HINTS
+
+#include "../include/sorted-hint.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    struct CountingLess {
+        size_t* calls;
+
+        template<
+            typename T,
+            typename U
+        > bool operator()(const T& a, const U& b) const {
+            ++*calls;
+
+            return a < b;
+        }
+    };
+};
+
+TEST(SortedHintTestSuite, AgreesWithScans) {
+    std::vector<int> a;
+
+    for (int value = 0; value < 50; ++value) {
+        for (int i = 0; i < value % 7; ++i) {
+            a.push_back(value);
+        }
+    }
+
+    auto sorted = lab::assume_sorted(a);
+    std::list<int> list(a.begin(), a.end());
+    auto sorted_list = lab::assume_sorted(list);
+
+    for (int x = -1; x <= 50; ++x) {
+        auto backward = lab::find_backward(a.begin(), a.end(), x);
+        auto point = std::find_if(a.begin(), a.end(), [x](int y) {
+            return y >= x;
+        });
+
+        ASSERT_EQ(lab::find_backward(sorted, x), backward);
+        ASSERT_EQ(std::distance(list.begin(), lab::find_backward(sorted_list, x)), backward - a.begin());
+        ASSERT_EQ(lab::partition_point(sorted, [x](int y) {
+            return y < x;
+        }), point);
+
+        for (size_t from = 0; from < a.size(); from += 5) {
+            auto tail = lab::assume_sorted(a.begin() + from, a.end());
+
+            ASSERT_EQ(lab::find_not(tail, x), lab::find_not(a.begin() + from, a.end(), x));
+        }
+
+        ASSERT_EQ(std::distance(list.begin(), lab::find_not(sorted_list, x)), lab::find_not(a.begin(), a.end(), x) - a.begin());
+    }
+
+    std::vector<int> empty;
+
+    ASSERT_EQ(lab::find_not(lab::assume_sorted(empty), 1), empty.end());
+    ASSERT_EQ(lab::find_backward(lab::assume_sorted(empty), 1), empty.end());
+}
+
+TEST(SortedHintTestSuite, CustomOrderAndHeterogeneousValues) {
+    std::vector<std::string> words = {"pear", "kiwi", "fig", "fig", "fig", "date", "apple"};
+    auto sorted = lab::assume_sorted(words, std::greater<>());
+
+    ASSERT_EQ(lab::find_backward(sorted, std::string_view("fig")) - words.begin(), 4);
+    ASSERT_EQ(lab::find_not(lab::assume_sorted(words.begin() + 2, words.end(), std::greater<>()), "fig") - words.begin(), 5);
+    ASSERT_EQ(lab::find_backward(sorted, "banana"), words.end());
+}
+
+TEST(SortedHintTestSuite, LogarithmicComparisons) {
+    std::vector<int> a(1 << 20, 7);
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int>(i / 3);
+    }
+
+    size_t calls = 0;
+    auto sorted = lab::assume_sorted(a, CountingLess{&calls});
+
+    calls = 0;
+    ASSERT_EQ(lab::find_backward(sorted, 1000) - a.begin(), 3002);
+    ASSERT_LE(calls, 24);
+
+    calls = 0;
+    ASSERT_EQ(lab::find_not(sorted, 0) - a.begin(), 3);
+    ASSERT_LE(calls, 8);
+
+    std::vector<int> run(1 << 20, 0);
+    run.back() = 1;
+
+    auto sorted_run = lab::assume_sorted(run, CountingLess{&calls});
+
+    calls = 0;
+    ASSERT_EQ(lab::find_not(sorted_run, 0), run.end() - 1);
+    ASSERT_LE(calls, 48);
+}
+
+TEST(SortedHintTestSuite, DebugChecks) {
+    std::vector<int> a(1000);
+
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int>(i % 2);
+    }
+
+    ASSERT_THROW(lab::assume_sorted(a), std::runtime_error);
+
+    std::vector<int> b(1000);
+
+    for (size_t i = 0; i < b.size(); ++i) {
+        b[i] = static_cast<int>(i);
+    }
+
+    ASSERT_NO_THROW(lab::assume_sorted(b));
+    ASSERT_THROW(lab::partition_point(lab::assume_sorted(b), [](int x) {
+        return x % 2 == 0;
+    }), std::runtime_error);
+}
@@ -0,0 +1,171 @@
+#include "../include/trackers.h"
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Copied {
+        static inline size_t copies = 0;
+
+        int value = 0;
+
+        Copied(int x)
+            : value(x)
+        {}
+
+        Copied(const Copied& other)
+            : value(other.value)
+        {
+            ++copies;
+        }
+
+        Copied& operator=(const Copied& other) {
+            value = other.value;
+            ++copies;
+
+            return *this;
+        }
+
+        bool operator<(const Copied& other) const {
+            return value < other.value;
+        }
+    };
+};
+
+TEST(TrackersTestSuite, SortedTrackerAgreesWithIsSortedUntil) {
+    std::mt19937 gen(5);
+
+    for (int trial = 0; trial < 200; ++trial) {
+        std::vector<int> all;
+        lab::sorted_tracker<int> by_element;
+        lab::sorted_tracker<int> by_batch;
+        lab::sorted_tracker<int, std::greater<int>> descending;
+
+        int value = 0;
+        int breaks = static_cast<int>(gen() % 3);
+
+        for (int batch = 0; batch < 10; ++batch) {
+            std::vector<int> chunk(gen() % 50);
+
+            for (int& x : chunk) {
+                value += 1 + static_cast<int>(gen() % 3);
+                x = value;
+
+                if (breaks > 0 && gen() % 300 == 0) {
+                    x -= 5;
+                    --breaks;
+                }
+            }
+
+            for (int x : chunk) {
+                by_element.push(x);
+                descending.push(-x);
+            }
+
+            by_batch.append(chunk);
+            all.insert(all.end(), chunk.begin(), chunk.end());
+
+            size_t until = lab::is_sorted_until(all.begin(), all.end()) - all.begin();
+
+            ASSERT_EQ(by_element.size(), all.size());
+            ASSERT_EQ(by_element.sorted_until(), until);
+            ASSERT_EQ(by_batch.sorted_until(), until);
+            ASSERT_EQ(descending.sorted_until(), until);
+            ASSERT_EQ(by_batch.is_sorted(), until == all.size());
+        }
+    }
+}
+
+TEST(TrackersTestSuite, SortedTrackerIsStrict) {
+    lab::sorted_tracker<std::string> words;
+    std::list<std::string> batch = {"b", "c"};
+
+    words.push("a");
+    words.append(batch.begin(), batch.end());
+
+    ASSERT_TRUE(words.is_sorted());
+
+    words.push("c");
+    words.push("d");
+
+    ASSERT_FALSE(words.is_sorted());
+    ASSERT_EQ(words.sorted_until(), 3);
+    ASSERT_EQ(words.size(), 5);
+
+    words.clear();
+    words.push("z");
+
+    ASSERT_TRUE(words.is_sorted());
+    ASSERT_EQ(words.size(), 1);
+}
+
+TEST(TrackersTestSuite, SortedTrackerStopsCopyingAfterViolation) {
+    lab::sorted_tracker<Copied> order;
+    std::vector<Copied> batch = {1, 2, 0, 3, 4};
+    std::vector<Copied> tail = {5, 6, 7};
+
+    Copied::copies = 0;
+    order.append(batch.begin(), batch.end());
+
+    ASSERT_EQ(Copied::copies, 0);
+    ASSERT_EQ(order.sorted_until(), 2);
+
+    for (int x = 10; x < 20; ++x) {
+        order.push(Copied(x));
+    }
+
+    order.append(tail.begin(), tail.end());
+
+    ASSERT_EQ(Copied::copies, 0);
+    ASSERT_EQ(order.size(), 18);
+    ASSERT_EQ(order.sorted_until(), 2);
+
+    lab::sorted_tracker<Copied> sorted;
+
+    sorted.append(tail.begin(), tail.end());
+    sorted.push(Copied(8));
+
+    ASSERT_EQ(Copied::copies, 2);
+    ASSERT_TRUE(sorted.is_sorted());
+}
+
+TEST(TrackersTestSuite, PartitionTracker) {
+    auto even = [](int x) {
+        return x % 2 == 0;
+    };
+
+    std::vector<int> all;
+    lab::partition_tracker<int, decltype(even)> tracker(even);
+
+    ASSERT_TRUE(tracker.is_partitioned());
+    ASSERT_EQ(tracker.partition_point(), 0);
+
+    for (int x : {2, 4, 6, 1, 3, 5, 8, 7, 10}) {
+        tracker.push(x);
+        all.push_back(x);
+
+        ASSERT_EQ(tracker.is_partitioned(), lab::is_partitioned(all.begin(), all.end(), even));
+        ASSERT_EQ(tracker.partitioned_until(), static_cast<size_t>(lab::is_partitioned_until(all.begin(), all.end(), even) - all.begin()));
+    }
+
+    ASSERT_EQ(tracker.partition_point(), 3);
+    ASSERT_EQ(tracker.partitioned_until(), 6);
+
+    size_t calls = 0;
+    lab::partition_tracker<int, std::function<bool(int)>> counted([&calls](int x) {
+        ++calls;
+
+        return x < 0;
+    });
+
+    counted.append(std::vector<int>{-1, 2, -3, 4, 5});
+
+    ASSERT_FALSE(counted.is_partitioned());
+    ASSERT_EQ(counted.partition_point(), 1);
+    ASSERT_EQ(calls, 3);
+}
@@ -2,6 +2,15 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <array>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
 TEST(XRangeTestSuite, IntTest) {
     auto range1 = lab::xrange(5);
     auto range2 = lab::xrange(3, 5);
@@ -80,3 +89,296 @@ TEST(XRangeTestSuite, InitTest) {
 
     ASSERT_TRUE(a == std::vector<int>({1, 3, 5}));
 }
+
+TEST(XRangeTestSuite, SizeTest) {
+    ASSERT_EQ(lab::xrange(5).size(), 5);
+    ASSERT_EQ(lab::xrange(1, 6, 2).size(), 3);
+    ASSERT_EQ(lab::xrange(1, 7, 2).size(), 3);
+    ASSERT_EQ(lab::xrange(6, 1, -2).size(), 3);
+    ASSERT_EQ(lab::xrange(1.5f, 5.5f, 2.5f).size(), 2);
+
+    ASSERT_TRUE(lab::xrange(5, 5).empty());
+    ASSERT_TRUE(lab::xrange(5, 1).empty());
+    ASSERT_TRUE(lab::xrange(1, 5, -1).empty());
+    ASSERT_FALSE(lab::xrange(1, 2).empty());
+}
+
+TEST(XRangeTestSuite, RandomAccessTest) {
+    static_assert(std::random_access_iterator<lab::xrange<int>::iterator>);
+
+    auto range = lab::xrange(10, 100, 3);
+    auto first = range.begin();
+    auto last = range.end();
+
+    ASSERT_EQ(std::distance(first, last), 30);
+    ASSERT_EQ(range[0], 10);
+    ASSERT_EQ(range[29], 97);
+    ASSERT_EQ(first[5], 25);
+    ASSERT_EQ(*(first + 7), 31);
+    ASSERT_EQ(*(last - 1), 97);
+
+    std::advance(first, 4);
+    ASSERT_EQ(*first, 22);
+
+    auto it = std::lower_bound(range.begin(), range.end(), 50);
+    ASSERT_EQ(*it, 52);
+    ASSERT_EQ(it - range.begin(), 14);
+}
+
+TEST(XRangeTestSuite, FloatStepCountTest) {
+    auto range1 = lab::xrange(0.0, 1.0, 0.1);
+    auto range2 = lab::xrange(0.0, 0.3, 0.1);
+    auto range3 = lab::xrange(1.0, 0.0, -0.1);
+
+    ASSERT_EQ(range1.size(), 10);
+    ASSERT_EQ(range2.size(), 3);
+    ASSERT_EQ(range3.size(), 10);
+
+    size_t i = 0;
+
+    for (auto x : range1) {
+        ASSERT_EQ(x, 0.0 + static_cast<double>(i) * 0.1);
+        ++i;
+    }
+
+    ASSERT_EQ(i, range1.size());
+}
+
+TEST(XRangeTestSuite, FloatCountMatchesValuesTest) {
+    std::vector<std::vector<float>> params = {
+        {0.0f, 1.0f, 1e-7f},
+        {-3.3f, 7.1f, 0.01f},
+        {100.0f, -100.0f, -0.3f},
+        {1.0f, 1.0000001f, 1e-9f}
+    };
+
+    for (const auto& p : params) {
+        auto range = lab::xrange(p[0], p[1], p[2]);
+        size_t n = range.size();
+
+        ASSERT_GT(n, 0);
+
+        if (p[2] > 0) {
+            ASSERT_LT(range[n - 1], p[1]);
+            ASSERT_GE(range[n], p[1]);
+        } else {
+            ASSERT_GT(range[n - 1], p[1]);
+            ASSERT_LE(range[n], p[1]);
+        }
+    }
+}
+
+TEST(XRangeTestSuite, OverflowingEndTest) {
+    auto range = lab::xrange(0, std::numeric_limits<int>::max(), 1 << 30);
+    std::vector<int> res{range.begin(), range.end()};
+
+    ASSERT_TRUE(res == std::vector<int>({0, 1 << 30}));
+
+    auto back = lab::xrange(std::numeric_limits<int>::min() + 1, std::numeric_limits<int>::min(), -1);
+    ASSERT_EQ(back.size(), 1);
+    ASSERT_EQ(*back.begin(), std::numeric_limits<int>::min() + 1);
+}
+
+template<typename T>
+void CheckFill(T start, T end, T step) {
+    auto range = lab::xrange(start, end, step);
+    std::vector<T> expected{range.begin(), range.end()};
+
+    std::vector<T> full(range.size());
+    ASSERT_EQ(range.fill(full), range.size());
+    ASSERT_TRUE(full == expected);
+
+    std::vector<T> prefix(range.size() / 2);
+    ASSERT_EQ(range.fill(prefix), prefix.size());
+    ASSERT_TRUE(std::equal(prefix.begin(), prefix.end(), expected.begin()));
+
+    std::vector<T> collected = {T(42)};
+    lab::collect_into(range, collected);
+    ASSERT_EQ(collected.size(), range.size() + 1);
+    ASSERT_TRUE(std::equal(collected.begin() + 1, collected.end(), expected.begin()));
+}
+
+TEST(XRangeTestSuite, FillTest) {
+    for (int n : {0, 1, 7, 31, 32, 33, 100, 1000}) {
+        CheckFill<int>(-5, n, 3);
+        CheckFill<int>(n, -5, -2);
+        CheckFill<long long>(1LL << 40, (1LL << 40) + n, 1);
+        CheckFill<short>(-300, static_cast<short>(n), 7);
+        CheckFill<unsigned char>(0, static_cast<unsigned char>(n % 256), 1);
+        CheckFill<float>(-1.5f, static_cast<float>(n), 0.1f);
+        CheckFill<double>(0.0, n, 0.01);
+        CheckFill<double>(n, -1.0, -0.3);
+    }
+
+    CheckFill<int>(0, std::numeric_limits<int>::max(), 1 << 20);
+}
+
+TEST(XRangeTestSuite, FillKernelsTest) {
+    const size_t count = 1000;
+    std::vector<int> expected_int(count);
+    std::vector<float> expected_float(count);
+    lab::simd::IotaScalar(expected_int.data(), count, -17, 5, 3);
+    lab::simd::IotaScalar(expected_float.data(), count, 0.25f, 0.1f, 3);
+
+    std::vector<int> out_int(count);
+    std::vector<float> out_float(count);
+
+    if (lab::simd::Supports(lab::simd::Isa::Sse2)) {
+        lab::simd::IotaIntSse2(out_int.data(), count, -17, 5, 3);
+        lab::simd::IotaFloatSse2(out_float.data(), count, 0.25f, 0.1f, 3);
+
+        ASSERT_TRUE(out_int == expected_int);
+        ASSERT_TRUE(out_float == expected_float);
+    }
+
+    if (lab::simd::Supports(lab::simd::Isa::Avx2)) {
+        lab::simd::IotaIntAvx2(out_int.data(), count, -17, 5, 3);
+        lab::simd::IotaFloatAvx2(out_float.data(), count, 0.25f, 0.1f, 3);
+
+        ASSERT_TRUE(out_int == expected_int);
+        ASSERT_TRUE(out_float == expected_float);
+    }
+}
+
+TEST(XRangeTestSuite, FillStreamingTest) {
+    auto range = lab::xrange(0, 3 << 20);
+    std::vector<int> out(range.size() + 1);
+    std::span<int> misaligned(out.data() + 1, range.size());
+
+    ASSERT_EQ(range.fill(misaligned), range.size());
+
+    for (size_t i = 0; i < range.size(); ++i) {
+        ASSERT_EQ(misaligned[i], static_cast<int>(i));
+    }
+}
+
+constexpr int StaticSum() {
+    int sum = 0;
+
+    lab::for_each_static(lab::static_xrange<1, 10, 3>(), [&sum](auto i) {
+        sum += i;
+    });
+
+    return sum;
+}
+
+TEST(XRangeTestSuite, ConstexprTest) {
+    static_assert(lab::xrange(1, 10, 2).size() == 5);
+    static_assert(lab::xrange(10, 1, -3)[2] == 4);
+    static_assert(*(lab::xrange(5).begin() + 3) == 3);
+    static_assert(lab::xrange(0.0, 1.0, 0.1).size() == 10);
+}
+
+TEST(XRangeTestSuite, StaticXRangeTest) {
+    static_assert(lab::static_xrange<8>::size() == 8);
+    static_assert(lab::static_xrange<2, 8>::get<0>() == 2);
+    static_assert(lab::static_xrange<0, 16, 4>::get<3>() == 12);
+    static_assert(lab::static_xrange<5, 5>::empty());
+    static_assert(StaticSum() == 1 + 4 + 7);
+
+    std::array<int, 4> lanes{};
+
+    lab::for_each_static(lab::static_xrange<4>(), [&lanes](auto i) {
+        std::get<i>(lanes) = i * 10;
+    });
+
+    ASSERT_TRUE(lanes == (std::array<int, 4>{0, 10, 20, 30}));
+
+    std::vector<int> res;
+
+    for (auto x : lab::static_xrange<6, 0, -2>()) {
+        res.push_back(x);
+    }
+
+    ASSERT_TRUE(res == std::vector<int>({6, 4, 2}));
+}
+
+TEST(XRangeTestSuite, IndexOfTest) {
+    auto range = lab::xrange(10, 100, 3);
+    auto back = lab::xrange(50, -50, -7);
+    auto floats = lab::xrange(0.0, 1.0, 0.125);
+
+    ASSERT_EQ(range.index_of(10), 0);
+    ASSERT_EQ(range.index_of(97), 29);
+    ASSERT_EQ(range.index_of(100), range.size());
+    ASSERT_EQ(range.index_of(11), range.size());
+    ASSERT_EQ(range.index_of(7), range.size());
+    ASSERT_EQ(range.index_of(10LL + (1LL << 32)), range.size());
+    ASSERT_TRUE(range.contains(52));
+    ASSERT_FALSE(range.contains(53));
+
+    ASSERT_EQ(back.index_of(-48), 14);
+    ASSERT_FALSE(back.contains(51));
+    ASSERT_FALSE(back.contains(-55));
+
+    ASSERT_EQ(floats.index_of(0.375), 3);
+    ASSERT_FALSE(floats.contains(0.3));
+    ASSERT_EQ(lab::xrange(1.0, 0.0, -0.25).index_of(0.5), 2);
+}
+
+TEST(XRangeTestSuite, ClosedFormAlgorithmsTest) {
+    auto range = lab::xrange(10, 100, 3);
+    auto back = lab::xrange(50, -50, -7);
+    auto single = lab::xrange(4, 5);
+
+    ASSERT_TRUE(lab::is_sorted(range.begin(), range.end()));
+    ASSERT_FALSE(lab::is_sorted(back.begin(), back.end()));
+    ASSERT_TRUE(lab::is_sorted(back.begin() + 3, back.begin() + 4));
+
+    ASSERT_FALSE(lab::is_palindrome(range.begin(), range.end()));
+    ASSERT_TRUE(lab::is_palindrome(single.begin(), single.end()));
+
+    ASSERT_TRUE(lab::find_not(range.begin(), range.end(), 10) == range.begin() + 1);
+    ASSERT_TRUE(lab::find_not(range.begin(), range.end(), 13) == range.begin());
+    ASSERT_TRUE(lab::find_not(single.begin(), single.end(), 4) == single.end());
+
+    ASSERT_TRUE(lab::find_backward(range.begin(), range.end(), 52) == range.begin() + 14);
+    ASSERT_TRUE(lab::find_backward(range.begin(), range.end(), 53) == range.end());
+    ASSERT_TRUE(lab::find_backward(range.begin() + 15, range.end(), 52) == range.end());
+    ASSERT_TRUE(lab::find_backward(back.begin(), back.end(), 1) == back.begin() + 7);
+    ASSERT_TRUE(lab::find_backward(single.begin(), single.end(), 4) == single.begin());
+
+    for (int x = -60; x < 110; ++x) {
+        auto expected = std::find(range.begin(), range.end(), x);
+
+        ASSERT_TRUE(lab::find_backward(range.begin(), range.end(), x) == expected);
+        ASSERT_TRUE(lab::find_backward(back.begin(), back.end(), x) == std::find(back.begin(), back.end(), x));
+    }
+}
+
+TEST(XRangeTestSuite, FmaTest) {
+    // (1 + 2^-30)(1 - 2^-30) - 1 is -2^-60, which a rounded product loses.
+    constexpr double a = 1 + 0x1p-30;
+    constexpr double b = 1 - 0x1p-30;
+
+    volatile double va = a;
+    volatile float vf = 1 + 0x1p-12f;
+
+    ASSERT_EQ(lab::base::xrange_fma(static_cast<double>(va), b, -1.0), -0x1p-60);
+    ASSERT_EQ(lab::base::xrange_fma(static_cast<double>(va), b, -1.0), std::fma(static_cast<double>(va), b, -1.0));
+    ASSERT_EQ(lab::base::xrange_fma(static_cast<float>(vf), 1 - 0x1p-12f, -1.0f), std::fma(static_cast<float>(vf), 1 - 0x1p-12f, -1.0f));
+
+#if defined(LAB_XRANGE_CONSTEXPR_FMA)
+    constexpr double folded = lab::base::xrange_fma(a, b, -1.0);
+    constexpr float folded_float = lab::base::xrange_fma(1 + 0x1p-12f, 1 - 0x1p-12f, -1.0f);
+
+    ASSERT_EQ(folded, -0x1p-60);
+    ASSERT_EQ(folded_float, std::fma(static_cast<float>(vf), 1 - 0x1p-12f, -1.0f));
+#endif
+}
+
+TEST(XRangeTestSuite, LengthLimitTest) {
+    constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+    constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+
+    ASSERT_THROW(lab::xrange<uint64_t>(0, std::numeric_limits<uint64_t>::max()), std::runtime_error);
+    ASSERT_THROW(lab::xrange<int64_t>(kMin, kMax), std::runtime_error);
+    ASSERT_THROW(lab::xrange<int64_t>(kMax, kMin, -2), std::runtime_error);
+
+    auto longest = lab::xrange<uint64_t>(0, PTRDIFF_MAX);
+
+    ASSERT_EQ(longest.size(), size_t(PTRDIFF_MAX));
+    ASSERT_EQ(longest.end() - longest.begin(), PTRDIFF_MAX);
+    ASSERT_EQ(longest[longest.size() - 1], uint64_t(PTRDIFF_MAX) - 1);
+    ASSERT_EQ(lab::xrange<int64_t>(kMin, kMax, 3).size(), size_t(PTRDIFF_MAX / 3 * 2 + 1));
+}
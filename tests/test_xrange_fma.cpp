@@ -0,0 +1,76 @@
+// Built as its own target with LAB_XRANGE_USE_FMA defined, so that the
+// fused paths are compiled and checked against each other.
+#include "../include/xrange.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#if !defined(LAB_XRANGE_USE_FMA)
+#error "test_xrange_fma.cpp must be built with LAB_XRANGE_USE_FMA"
+#endif
+
+namespace {
+    // fill(), operator[] and iteration give the same values, each the
+    // fused start + i * step.
+    template<typename T>
+    void CheckFused(T start, T end, T step) {
+        lab::xrange<T> range(start, end, step);
+        std::vector<T> filled(range.size() + 3, T(-1));
+
+        ASSERT_EQ(range.fill(filled), range.size());
+        ASSERT_EQ(filled[range.size()], T(-1));
+
+        size_t i = 0;
+
+        for (T value : range) {
+            ASSERT_EQ(value, std::fma(static_cast<T>(i), step, start)) << i;
+            ASSERT_EQ(range[i], value) << i;
+            ASSERT_EQ(filled[i], value) << i;
+            ++i;
+        }
+
+        ASSERT_EQ(i, range.size());
+    }
+};
+
+TEST(XRangeFmaTestSuite, FillAgreesWithIteration) {
+    CheckFused(0.1, 1000.0, 0.7);
+    CheckFused(1.0 / 3, -50.0, -0.11);
+    CheckFused(0.1f, 300.0f, 0.3f);
+    CheckFused(-7.25f, 7.0f, 1.0f / 3);
+
+    for (size_t n = 0; n < 70; ++n) {
+        CheckFused(0.1, 0.1 + 0.01 * static_cast<double>(n), 0.01);
+    }
+}
+
+#if defined(LAB_XRANGE_CONSTEXPR_FMA)
+TEST(XRangeFmaTestSuite, StaticValuesAgree) {
+    using Range = lab::static_xrange<0.1, 10.0, 0.7>;
+    using FloatRange = lab::static_xrange<0.1f, 3.0f, 0.3f>;
+
+    constexpr double kFolded = Range::get<9>();
+    constexpr float kFoldedFloat = FloatRange::get<7>();
+
+    volatile size_t nine = 9;
+    volatile size_t seven = 7;
+
+    ASSERT_EQ(kFolded, Range::range[nine]);
+    ASSERT_EQ(kFoldedFloat, FloatRange::range[seven]);
+
+    std::vector<double> filled(Range::size());
+    Range::range.fill(filled);
+
+    size_t i = 0;
+
+    lab::for_each_static(Range(), [&filled, &i](auto value) {
+        ASSERT_EQ(decltype(value)::value, filled[i]) << i;
+        ++i;
+    });
+
+    ASSERT_EQ(i, Range::size());
+}
+#endif
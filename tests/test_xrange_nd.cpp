@@ -0,0 +1,147 @@
+#include "../include/parallel.h"
+#include "../include/xrange-nd.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <set>
+#include <utility>
+#include <vector>
+
+TEST(XRangeNdTestSuite, RowMajorTest) {
+    std::vector<std::pair<int, int>> res;
+
+    for (auto [i, j] : lab::xrange_nd(lab::xrange(1, 3), lab::xrange(10, 0, -4))) {
+        res.emplace_back(i, j);
+    }
+
+    std::vector<std::pair<int, int>> ans = {
+        {1, 10}, {1, 6}, {1, 2},
+        {2, 10}, {2, 6}, {2, 2}
+    };
+
+    ASSERT_TRUE(res == ans);
+    ASSERT_EQ(lab::xrange_nd(lab::xrange(3), lab::xrange(4), lab::xrange(5)).size(), 60);
+}
+
+TEST(XRangeNdTestSuite, EmptyTest) {
+    auto range = lab::xrange_nd(lab::xrange(3), lab::xrange(0), lab::xrange(5));
+
+    ASSERT_TRUE(range.empty());
+    ASSERT_TRUE(range.begin() == range.end());
+}
+
+TEST(XRangeNdTestSuite, BlockedTest) {
+    lab::tiled_xrange<int, 2> range(lab::xrange_nd(lab::xrange(5), lab::xrange(4)), {2, 3});
+    std::vector<std::array<int, 2>> res{range.begin(), range.end()};
+
+    std::vector<std::array<int, 2>> ans = {
+        {0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}, {1, 2},
+        {0, 3}, {1, 3},
+        {2, 0}, {2, 1}, {2, 2}, {3, 0}, {3, 1}, {3, 2},
+        {2, 3}, {3, 3},
+        {4, 0}, {4, 1}, {4, 2},
+        {4, 3}
+    };
+
+    ASSERT_EQ(range.tile_count(), 6);
+    ASSERT_TRUE(res == ans);
+}
+
+TEST(XRangeNdTestSuite, MortonTest) {
+    lab::tiled_xrange<int, 2> range(lab::xrange_nd(lab::xrange(4), lab::xrange(4)), {1, 1}, lab::tile_order::morton);
+    std::vector<std::array<int, 2>> res{range.begin(), range.end()};
+
+    std::vector<std::array<int, 2>> ans = {
+        {0, 0}, {0, 1}, {1, 0}, {1, 1},
+        {0, 2}, {0, 3}, {1, 2}, {1, 3},
+        {2, 0}, {2, 1}, {3, 0}, {3, 1},
+        {2, 2}, {2, 3}, {3, 2}, {3, 3}
+    };
+
+    ASSERT_TRUE(res == ans);
+}
+
+TEST(XRangeNdTestSuite, MortonUnevenGridTest) {
+    // Reference order: every tile of the grid, sorted by interleaved bits.
+    auto code = [](const std::array<size_t, 3>& coords) {
+        uint64_t res = 0;
+
+        for (size_t bit = 0; bit < 21; ++bit) {
+            for (size_t d = 0; d < 3; ++d) {
+                res |= static_cast<uint64_t>((coords[d] >> bit) & 1) << (bit * 3 + (2 - d));
+            }
+        }
+
+        return res;
+    };
+
+    for (std::array<size_t, 3> grid : {std::array<size_t, 3>{3, 5, 1}, {1, 1, 9}, {6, 2, 5}, {7, 7, 7}}) {
+        lab::tiled_xrange<size_t, 3> range(
+            lab::xrange_nd(lab::xrange(grid[0] * 2), lab::xrange(grid[1] * 2), lab::xrange(grid[2] * 2)),
+            {2, 2, 2},
+            lab::tile_order::morton
+        );
+
+        std::vector<std::array<size_t, 3>> ans;
+
+        for (auto index : lab::xrange_nd(lab::xrange(grid[0]), lab::xrange(grid[1]), lab::xrange(grid[2]))) {
+            ans.push_back(index);
+        }
+
+        std::sort(ans.begin(), ans.end(), [&code](const auto& a, const auto& b) {
+            return code(a) < code(b);
+        });
+
+        ASSERT_EQ(range.tile_count(), ans.size());
+
+        for (size_t k = 0; k < ans.size(); ++k) {
+            std::array<size_t, 3> lo = range.tile(k).lower();
+
+            ASSERT_EQ(lo[0] / 2, ans[k][0]);
+            ASSERT_EQ(lo[1] / 2, ans[k][1]);
+            ASSERT_EQ(lo[2] / 2, ans[k][2]);
+        }
+    }
+}
+
+TEST(XRangeNdTestSuite, TiledCoversAllTest) {
+    for (auto order : {lab::tile_order::blocked, lab::tile_order::morton}) {
+        lab::tiled_xrange<int, 3> range(
+            lab::xrange_nd(lab::xrange(7), lab::xrange(2, 13, 3), lab::xrange(5, 0, -1)),
+            {3, 2, 4},
+            order
+        );
+
+        std::set<std::array<int, 3>> seen;
+        size_t count = 0;
+
+        for (auto index : range) {
+            seen.insert(index);
+            ++count;
+        }
+
+        ASSERT_EQ(count, range.size());
+        ASSERT_EQ(seen.size(), 7 * 4 * 5);
+    }
+}
+
+TEST(XRangeNdTestSuite, ParallelTest) {
+    auto grid = lab::xrange_nd(lab::xrange(100), lab::xrange(70));
+    std::vector<std::atomic<int>> hits(100 * 70);
+
+    lab::parallel_for(lab::tiled_xrange<int, 2>(grid, {16, 16}, lab::tile_order::morton), [&hits](std::array<int, 2> index) {
+        hits[index[0] * 70 + index[1]].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    lab::parallel_for(grid, [&hits](std::array<int, 2> index) {
+        hits[index[0] * 70 + index[1]].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    for (const auto& hit : hits) {
+        ASSERT_EQ(hit.load(), 2);
+    }
+}
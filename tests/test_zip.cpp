@@ -2,9 +2,16 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <forward_list>
+#include <iterator>
 #include <list>
+#include <memory>
 #include <set>
+#include <string>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 TEST(ZipTestSuite, SameTypesSameContainers) {
     std::vector<int> a = {1, 2, 3, 4};
@@ -160,3 +167,212 @@ TEST(ZipTestSuite, InitTest) {
 
     ASSERT_TRUE(v == ans);
 }
+
+TEST(ZipTestSuite, ThreeSequences) {
+    std::vector<int> a = {1, 2, 3, 4};
+    std::list<char> b = {'a', 'b', 'c'};
+    std::vector<std::string> c = {"x", "y", "z", "w"};
+
+    std::vector<std::tuple<int, char, std::string>> ans = {
+        {1, 'a', "x"},
+        {2, 'b', "y"},
+        {3, 'c', "z"}
+    };
+
+    std::vector<std::tuple<int, char, std::string>> res;
+
+    for (auto [x, y, z] : lab::zip(a, b, c)) {
+        res.emplace_back(x, y, z);
+    }
+
+    ASSERT_TRUE(res == ans);
+}
+
+TEST(ZipTestSuite, WritesThrough) {
+    std::vector<int> a = {1, 2, 3};
+    std::vector<std::string> b = {"a", "b", "c"};
+    std::vector<double> c = {0.5, 1.5, 2.5};
+
+    for (auto [x, y, z] : lab::zip(a, b, c)) {
+        x *= 10;
+        y += "!";
+        z = -z;
+    }
+
+    ASSERT_EQ(a, std::vector<int>({10, 20, 30}));
+    ASSERT_EQ(b, std::vector<std::string>({"a!", "b!", "c!"}));
+    ASSERT_EQ(c, std::vector<double>({-0.5, -1.5, -2.5}));
+
+    auto z = lab::zip(a, b);
+    auto it = z.begin();
+    auto first = *it;
+    auto second = *++it;
+
+    first = second;
+    ASSERT_EQ(a[0], 20);
+    ASSERT_EQ(b[0], "b!");
+
+    second = std::make_pair(7, std::string("seven"));
+    ASSERT_EQ(a[1], 7);
+    ASSERT_EQ(b[1], "seven");
+
+    using std::swap;
+    swap(*z.begin(), *++z.begin());
+    ASSERT_EQ(a[0], 7);
+    ASSERT_EQ(b[0], "seven");
+    ASSERT_EQ(a[1], 20);
+    ASSERT_EQ(b[1], "b!");
+}
+
+namespace {
+    struct CopyCounter {
+        static inline size_t copies = 0;
+
+        CopyCounter() = default;
+
+        CopyCounter(const CopyCounter&) {
+            ++copies;
+        }
+
+        CopyCounter& operator=(const CopyCounter&) {
+            ++copies;
+
+            return *this;
+        }
+    };
+};
+
+TEST(ZipTestSuite, NoElementCopies) {
+    std::vector<CopyCounter> a(5);
+    std::list<CopyCounter> b(4);
+    std::vector<CopyCounter> c(6);
+
+    CopyCounter::copies = 0;
+    size_t steps = 0;
+
+    for (auto [x, y, z] : lab::zip(a, b, c)) {
+        ASSERT_EQ(&x, &a[steps]);
+        ASSERT_EQ(&z, &c[steps]);
+        ++steps;
+    }
+
+    for (auto value : lab::zip(a, b)) {
+        (void)value.first;
+    }
+
+    ASSERT_EQ(steps, 4);
+    ASSERT_EQ(CopyCounter::copies, 0);
+}
+
+TEST(ZipTestSuite, MovesFromTemporaries) {
+    std::vector<std::string> names = {std::string(40, 'a'), std::string(40, 'b'), std::string(40, 'c')};
+    std::vector<std::unique_ptr<int>> owned;
+
+    for (int i = 0; i < 3; ++i) {
+        owned.push_back(std::make_unique<int>(i));
+    }
+
+    auto z = lab::zip(names, owned);
+
+    *z.begin() = std::move(*(z.begin() + 2));
+
+    ASSERT_EQ(names[0], std::string(40, 'c'));
+    ASSERT_EQ(*owned[0], 2);
+    ASSERT_TRUE(names[2].empty());
+    ASSERT_EQ(owned[2], nullptr);
+
+    // Standard algorithms move rows through the proxies.
+    std::move_backward(z.begin(), z.begin() + 2, z.end());
+
+    ASSERT_EQ(names[2], std::string(40, 'b'));
+    ASSERT_EQ(*owned[2], 1);
+    ASSERT_EQ(names[1], std::string(40, 'c'));
+    ASSERT_EQ(*owned[1], 2);
+
+    // A named proxy is copied from.
+    std::vector<int> ids = {1, 2};
+    auto copies = lab::zip(names, ids);
+    auto source = *(copies.begin() + 1);
+
+    *copies.begin() = source;
+
+    ASSERT_EQ(names[0], std::string(40, 'c'));
+    ASSERT_EQ(names[1], std::string(40, 'c'));
+    ASSERT_EQ(ids[0], 2);
+}
+
+TEST(ZipTestSuite, Categories) {
+    std::vector<int> a = {1, 2, 3};
+    std::list<int> b = {1, 2, 3};
+    std::forward_list<int> c = {1, 2, 3};
+
+    using VectorZip = lab::zip<std::vector<int>, std::vector<int>>;
+    using ListZip = lab::zip<std::vector<int>, std::list<int>>;
+    using ForwardZip = lab::zip<std::list<int>, std::forward_list<int>>;
+
+    static_assert(std::random_access_iterator<VectorZip::iterator>);
+    static_assert(std::is_same_v<ListZip::iterator::iterator_category, std::bidirectional_iterator_tag>);
+    static_assert(std::is_same_v<ForwardZip::iterator::iterator_category, std::forward_iterator_tag>);
+    static_assert(std::ranges::sized_range<ListZip>);
+    static_assert(!std::ranges::sized_range<ForwardZip>);
+
+    size_t count = 0;
+
+    for (auto [x, y] : lab::zip(b, c)) {
+        ASSERT_EQ(x, y);
+        ++count;
+    }
+
+    ASSERT_EQ(count, 3);
+}
+
+TEST(ZipTestSuite, SizeAndIndexing) {
+    std::vector<int> a = {1, 2, 3, 4, 5};
+    std::vector<char> b = {'a', 'b', 'c'};
+    std::list<double> c = {0.5, 1.5, 2.5, 3.5};
+
+    auto z = lab::zip(a, b);
+
+    ASSERT_EQ(z.size(), 3);
+    ASSERT_EQ(z.end() - z.begin(), 3);
+    ASSERT_EQ(z.begin()[2].first, 3);
+    ASSERT_EQ((*(z.end() - 1)).second, 'c');
+    ASSERT_TRUE(z.begin() < z.end());
+    ASSERT_FALSE(z.empty());
+
+    // Stepping back from the end stays in step even when a longer
+    // container is only bidirectional.
+    auto w = lab::zip(b, c);
+    auto last = std::prev(w.end());
+
+    ASSERT_EQ(w.size(), 3);
+    ASSERT_EQ((*last).first, 'c');
+    ASSERT_EQ((*last).second, 2.5);
+
+    std::vector<std::pair<int, char>> copy(z.begin(), z.end());
+
+    ASSERT_EQ(copy.size(), 3);
+    ASSERT_EQ(copy.back(), std::make_pair(3, 'c'));
+}
+
+TEST(ZipTestSuite, SortAndSearch) {
+    std::vector<int> keys = {5, 3, 9, 1, 3, 7};
+    std::vector<std::string> values = {"five", "three-b", "nine", "one", "three-a", "seven"};
+    auto z = lab::zip(keys, values);
+
+    std::sort(z.begin(), z.end());
+
+    ASSERT_EQ(keys, std::vector<int>({1, 3, 3, 5, 7, 9}));
+    ASSERT_EQ(values, std::vector<std::string>({"one", "three-a", "three-b", "five", "seven", "nine"}));
+
+    auto it = std::lower_bound(z.begin(), z.end(), std::make_pair(5, std::string()));
+
+    ASSERT_EQ(it - z.begin(), 3);
+
+    std::ranges::sort(z, [](const auto& a, const auto& b) {
+        return std::get<1>(a) < std::get<1>(b);
+    });
+
+    ASSERT_EQ(values, std::vector<std::string>({"five", "nine", "one", "seven", "three-a", "three-b"}));
+    ASSERT_EQ(keys, std::vector<int>({5, 9, 1, 7, 3, 3}));
+}
@@ -0,0 +1,206 @@
+#include "../include/zip-sort.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // Counts copies, so that a test can check rows are only moved.
+    struct Counted {
+        static inline size_t copies = 0;
+
+        int value = 0;
+
+        Counted(int x)
+            : value(x)
+        {}
+
+        Counted(const Counted& other)
+            : value(other.value)
+        {
+            ++copies;
+        }
+
+        Counted(Counted&&) noexcept = default;
+
+        Counted& operator=(const Counted& other) {
+            value = other.value;
+            ++copies;
+
+            return *this;
+        }
+
+        Counted& operator=(Counted&&) noexcept = default;
+    };
+
+    // Sorts keys together with their original positions and checks that the
+    // keys are ordered and every row still holds its own payload.
+    template<typename T>
+    void CheckSortedRows(std::vector<T> keys) {
+        std::vector<T> original = keys;
+        std::vector<size_t> positions(keys.size());
+
+        for (size_t i = 0; i < positions.size(); ++i) {
+            positions[i] = i;
+        }
+
+        lab::sort(lab::zip(keys, positions));
+
+        std::vector<T> expected = original;
+        std::sort(expected.begin(), expected.end());
+
+        ASSERT_EQ(keys, expected);
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(original[positions[i]], keys[i]);
+        }
+    }
+};
+
+TEST(ZipSortTestSuite, Integers) {
+    std::mt19937_64 gen(42);
+
+    std::vector<int64_t> wide(100000);
+    for (auto& x : wide) {
+        x = static_cast<int64_t>(gen());
+    }
+    CheckSortedRows(wide);
+
+    std::vector<int> narrow(50000);
+    for (auto& x : narrow) {
+        x = static_cast<int>(gen() % 2000) - 1000;
+    }
+    CheckSortedRows(narrow);
+
+    std::vector<uint8_t> bytes(10000);
+    for (auto& x : bytes) {
+        x = static_cast<uint8_t>(gen());
+    }
+    CheckSortedRows(bytes);
+
+    CheckSortedRows(std::vector<int>{});
+    CheckSortedRows(std::vector<int>{3, 1, 2});
+    CheckSortedRows(std::vector<int>(1000, 7));
+    CheckSortedRows(std::vector<int>{std::numeric_limits<int>::max(), 0, std::numeric_limits<int>::min(), -1});
+}
+
+TEST(ZipSortTestSuite, Floats) {
+    std::mt19937_64 gen(7);
+    std::uniform_real_distribution<double> dist(-1e6, 1e6);
+
+    std::vector<double> doubles(100000);
+    for (auto& x : doubles) {
+        x = dist(gen);
+    }
+    doubles[10] = std::numeric_limits<double>::infinity();
+    doubles[20] = -std::numeric_limits<double>::infinity();
+    doubles[30] = std::numeric_limits<double>::denorm_min();
+    CheckSortedRows(doubles);
+
+    std::vector<float> floats(20000);
+    for (auto& x : floats) {
+        x = static_cast<float>(dist(gen));
+    }
+    CheckSortedRows(floats);
+}
+
+TEST(ZipSortTestSuite, SeveralSequences) {
+    std::vector<int> keys = {5, -3, 9, 1, 0};
+    std::vector<std::string> names = {"five", "minus three", "nine", "one", "zero"};
+    std::vector<double> weights = {5.5, -3.5, 9.5, 1.5, 0.5};
+
+    lab::sort(lab::zip(keys, names, weights));
+
+    ASSERT_EQ(keys, std::vector<int>({-3, 0, 1, 5, 9}));
+    ASSERT_EQ(names, std::vector<std::string>({"minus three", "zero", "one", "five", "nine"}));
+    ASSERT_EQ(weights, std::vector<double>({-3.5, 0.5, 1.5, 5.5, 9.5}));
+}
+
+TEST(ZipSortTestSuite, Comparator) {
+    std::vector<std::string> keys = {"b", "c", "a"};
+    std::vector<int> values = {2, 3, 1};
+
+    lab::sort(lab::zip(keys, values));
+
+    ASSERT_EQ(keys, std::vector<std::string>({"a", "b", "c"}));
+    ASSERT_EQ(values, std::vector<int>({1, 2, 3}));
+
+    std::vector<int> numbers = {1, 3, 2};
+    std::vector<char> letters = {'a', 'c', 'b'};
+
+    lab::sort(lab::zip(numbers, letters), std::greater<>());
+
+    ASSERT_EQ(numbers, std::vector<int>({3, 2, 1}));
+    ASSERT_EQ(letters, std::vector<char>({'c', 'b', 'a'}));
+}
+
+TEST(ZipSortTestSuite, MovesRows) {
+    std::mt19937_64 gen(7);
+    std::vector<std::string> words;
+    std::vector<Counted> payload;
+
+    for (int i = 0; i < 5000; ++i) {
+        int x = static_cast<int>(gen() % 1000);
+
+        words.push_back(std::to_string(x));
+        payload.emplace_back(x);
+    }
+
+    Counted::copies = 0;
+    lab::sort(lab::zip(words, payload), std::greater<>());
+
+    ASSERT_EQ(Counted::copies, 0);
+    ASSERT_TRUE(std::is_sorted(words.begin(), words.end(), std::greater<>()));
+
+    for (size_t i = 0; i < words.size(); ++i) {
+        ASSERT_EQ(std::to_string(payload[i].value), words[i]);
+    }
+
+    std::vector<int> numbers;
+
+    for (const auto& x : payload) {
+        numbers.push_back(x.value);
+    }
+
+    lab::sort(lab::zip(numbers, payload));
+
+    ASSERT_EQ(Counted::copies, 0);
+    ASSERT_TRUE(std::is_sorted(numbers.begin(), numbers.end()));
+
+    for (size_t i = 0; i < numbers.size(); ++i) {
+        ASSERT_EQ(payload[i].value, numbers[i]);
+    }
+}
+
+TEST(ZipSortTestSuite, MoveOnlyColumn) {
+    std::vector<std::string> words = {"pear", "fig", "kiwi", "apple"};
+    std::vector<int> numbers = {3, 1, 2, 0};
+    std::vector<std::unique_ptr<int>> owned;
+
+    for (int x : numbers) {
+        owned.push_back(std::make_unique<int>(x));
+    }
+
+    lab::sort(lab::zip(words, owned), std::greater<>());
+
+    ASSERT_EQ(words, std::vector<std::string>({"pear", "kiwi", "fig", "apple"}));
+    ASSERT_EQ(*owned[1], 2);
+
+    for (size_t i = 0; i < owned.size(); ++i) {
+        numbers[i] = *owned[i];
+    }
+
+    lab::sort(lab::zip(numbers, owned));
+
+    for (size_t i = 0; i < owned.size(); ++i) {
+        ASSERT_EQ(numbers[i], static_cast<int>(i));
+        ASSERT_EQ(*owned[i], static_cast<int>(i));
+    }
+}